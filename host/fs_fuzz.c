@@ -0,0 +1,122 @@
+/* fs_fuzz.c - 기억FS libFuzzer 드라이버 */
+/* 입력 바이트열을 셸 명령 시퀀스로 해석해 파일 시스템 함수를 호출하고,
+   매 단계마다 슬롯 불변식을 확인한다. "make fuzz"로 빌드 (clang 필요). */
+#include "hosted.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* 바이트에서 짧은 경로 이름을 만든다: 충돌이 자주 나도록 작은 알파벳 사용 */
+static size_t take_name(const uint8_t* data, size_t size, size_t pos, char* out) {
+    static const char alphabet[] = "ab/.";
+    int len = 0;
+    if (pos < size) {
+        int want = 1 + data[pos++] % 6;
+        while (len < want && pos < size)
+            out[len++] = alphabet[data[pos++] % 4];
+    }
+    if (len == 0) out[len++] = 'a';
+    out[len] = '\0';
+    return pos;
+}
+
+/* 입력 일부를 파일 내용으로 써 보고, 전체/부분 읽기가 원본과 같은지 확인.
+   공간 부족으로 실패하면 기존 내용이 그대로여야 한다 */
+static size_t write_and_verify(const uint8_t* data, size_t size, size_t pos, const char* name) {
+    static char back[MAX_FILE_SIZE], old[MAX_FILE_SIZE];
+    char full[MAX_FILENAME_LEN];
+    size_t len = pos < size ? data[pos++] * 4 : 0;
+    if (len > size - pos) len = size - pos;
+    build_full_path(name, full, MAX_FILENAME_LEN);
+    int idx = fs_find(full);
+    if (idx < 0 || fs.files[idx].is_directory) return pos + len;
+    size_t old_size = fs_read(idx, 0, old, MAX_FILE_SIZE);
+    if (fs_write(idx, (const char*)data + pos, len) != 0) {
+        if (fs_read(idx, 0, back, MAX_FILE_SIZE) != old_size || memcmp(back, old, old_size) != 0)
+            abort();
+    } else {
+        if (fs_read(idx, 0, back, MAX_FILE_SIZE) != len || memcmp(back, data + pos, len) != 0)
+            abort();
+        size_t off = len / 3, part = len / 2;
+        if (fs_read(idx, off, back, part) != part || memcmp(back, data + pos + off, part) != 0)
+            abort();
+    }
+    return pos + len;
+}
+
+/* 압축기 왕복: 압축에 성공하면 해제 결과가 원본과 같아야 한다 */
+static void lz_roundtrip(const uint8_t* data, size_t size) {
+    static uint8_t packed[FS_CHUNK_SIZE], plain[FS_CHUNK_SIZE];
+    int n = size < FS_CHUNK_SIZE ? (int)size : FS_CHUNK_SIZE;
+    int c = lz_compress(data, n, packed, n - 1);
+    if (c > 0 && (lz_decompress(packed, c, plain, FS_CHUNK_SIZE) != n || memcmp(plain, data, n) != 0))
+        abort();
+    lz_decompress(data, n, plain, FS_CHUNK_SIZE);    /* 임의 입력에도 안전해야 함 */
+}
+
+/* 색인 후보는 실제로 패턴을 포함하는 파일을 모두 포함해야 한다 */
+static void check_index(const char* pat) {
+    static char text[MAX_FILE_SIZE];
+    size_t m = kstrlen(pat);
+    fs_mask_t names = fs_index_candidates(fs_name_index, pat, m);
+    fs_mask_t contents = fs_index_candidates(fs_content_index, pat, m);
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (!fs.files[i].used) continue;
+        if (kmemsearch(fs.files[i].name, kstrlen(fs.files[i].name), pat, m) >= 0 &&
+            !(names & (1u << i)))
+            abort();
+        size_t n = fs_read(i, 0, text, MAX_FILE_SIZE);
+        if (kmemsearch(text, n, pat, m) >= 0 && !(contents & (1u << i)))
+            abort();
+    }
+}
+
+/* 트라이그램 단위 제거가 남긴 비트가 없어야 한다: 처음부터 다시 만든 색인과 같아야 함 */
+static void check_index_exact(void) {
+    static fs_mask_t names[FS_TRIGRAM_BUCKETS], contents[FS_TRIGRAM_BUCKETS];
+    static char text[MAX_FILE_SIZE];
+    memset(names, 0, sizeof(names));
+    memset(contents, 0, sizeof(contents));
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (!fs.files[i].used) continue;
+        fs_index_add(names, i, fs.files[i].name, kstrlen(fs.files[i].name));
+        fs_index_add(contents, i, text, fs_read(i, 0, text, MAX_FILE_SIZE));
+    }
+    if (memcmp(names, fs_name_index, sizeof(names)) != 0 ||
+        memcmp(contents, fs_content_index, sizeof(contents)) != 0)
+        abort();
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    char a[MAX_FILENAME_LEN], b[MAX_FILENAME_LEN], full[MAX_FILENAME_LEN];
+    lz_roundtrip(data, size);
+    init_fs();
+    kstrncpy(current_directory, "/", sizeof(current_directory));
+    size_t pos = 0;
+    while (pos < size) {
+        uint8_t op = data[pos++] % 11;
+        pos = take_name(data, size, pos, a);
+        pos = take_name(data, size, pos, b);
+        switch (op) {
+        case 0: fs_create_file(a); break;
+        case 1: fs_create_directory(a); break;
+        case 2: build_full_path(a, full, MAX_FILENAME_LEN); fs_delete(full); break;
+        case 3: fs_change_directory(a); break;
+        case 4: fs_change_directory(".."); break;
+        case 5: fs_copy_file(a, b); break;
+        case 6: fs_move_file(a, b); break;
+        case 7: fs_touch(a); break;
+        case 8: fs_link_file(a, b); break;
+        case 9: pos = write_and_verify(data, size, pos, a); break;
+        case 10:
+            build_full_path(a, full, MAX_FILENAME_LEN);
+            if (fs_find(full) > 0 && !fs.files[fs_find(full)].is_directory)
+                fs_set_compression(fs_find(full), b[0] == 'a');
+            break;
+        }
+        if (!hosted_fs_consistent()) abort();
+        check_index(b);
+        check_index_exact();
+    }
+    return 0;
+}
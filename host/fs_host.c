@@ -0,0 +1,121 @@
+/* fs_host.c - 기억FS/문자열 함수 네이티브 벤치마크 */
+/* 커널 bench 명령과 같은 항목을 호스트에서 측정한다 (단위: ns).
+   출력 형식: "host,<name>,<param>,<iters>,<min>,<median>,<p99>" */
+#include "hosted.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+#define HOST_ITERS 1001
+
+static long long samples[HOST_ITERS];
+static volatile int sink;
+
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int cmp_ll(const void* a, const void* b) {
+    long long x = *(const long long*)a, y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char* name, long param) {
+    qsort(samples, HOST_ITERS, sizeof(samples[0]), cmp_ll);
+    printf("host,%s,%ld,%d,%lld,%lld,%lld\n", name, param, HOST_ITERS,
+           samples[0], samples[HOST_ITERS / 2],
+           samples[(HOST_ITERS * 99 + 99) / 100 - 1]);
+}
+
+static void bench_fs_find(void) {
+    char name[MAX_FILENAME_LEN];
+    init_fs();
+    for (int n = 1; n < MAX_FILES; n++) {
+        snprintf(name, sizeof(name), ".bench%d", n);
+        fs_create_file(name);
+    }
+    for (int i = 0; i < HOST_ITERS; i++) {
+        long long t0 = now_ns();
+        sink = fs_find("/.bench-missing");
+        samples[i] = now_ns() - t0;
+    }
+    report("fs_find", fs.file_count);
+
+    init_fs();
+    for (int i = 0; i < HOST_ITERS; i++) {
+        long long t0 = now_ns();
+        fs_create_file(".churn");
+        fs_delete("/.churn");
+        samples[i] = now_ns() - t0;
+    }
+    report("fs_churn", fs.file_count);
+}
+
+static void bench_strings(void) {
+    static char src[4096], dst[4096];
+    static const int sizes[] = { 16, 64, 256, 1024, 4096 };
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        for (int i = 0; i < HOST_ITERS; i++) {
+            long long t0 = now_ns();
+            kmemcpy(dst, src, sizes[s]);
+            samples[i] = now_ns() - t0;
+        }
+        report("kmemcpy", sizes[s]);
+    }
+
+    char a[MAX_FILENAME_LEN], b[MAX_FILENAME_LEN];
+    for (int i = 0; i < MAX_FILENAME_LEN - 1; i++) a[i] = b[i] = 'a' + (i % 26);
+    a[MAX_FILENAME_LEN - 1] = b[MAX_FILENAME_LEN - 1] = '\0';
+    b[MAX_FILENAME_LEN - 2] = '#';
+    for (int i = 0; i < HOST_ITERS; i++) {
+        long long t0 = now_ns();
+        sink = kstrcmp(a, b);
+        samples[i] = now_ns() - t0;
+    }
+    report("kstrcmp", MAX_FILENAME_LEN - 1);
+    for (int i = 0; i < HOST_ITERS; i++) {
+        long long t0 = now_ns();
+        sink = kstrcontains(a, "abcdx");
+        samples[i] = now_ns() - t0;
+    }
+    report("kstrcontains", MAX_FILENAME_LEN - 1);
+
+    /* 1KB 내용에서 없는 패턴 검색 (Horspool) */
+    for (int i = 0; i < MAX_FILE_SIZE; i++) src[i] = 'a' + (i % 26);
+    for (int i = 0; i < HOST_ITERS; i++) {
+        long long t0 = now_ns();
+        sink = kmemsearch(src, MAX_FILE_SIZE, "abcdx", 5);
+        samples[i] = now_ns() - t0;
+    }
+    report("kmemsearch", MAX_FILE_SIZE);
+
+    static const char text[] = "the quick brown fox jumps over the lazy dog. ";
+    for (int i = 0; i < FS_CHUNK_SIZE; i++) src[i] = text[i % (sizeof(text) - 1)];
+    int packed = 0;
+    for (int i = 0; i < HOST_ITERS; i++) {
+        long long t0 = now_ns();
+        packed = lz_compress((const uint8_t*)src, FS_CHUNK_SIZE, (uint8_t*)dst, FS_CHUNK_SIZE - 1);
+        samples[i] = now_ns() - t0;
+    }
+    report("lz_compress", FS_CHUNK_SIZE);
+    for (int i = 0; i < HOST_ITERS; i++) {
+        long long t0 = now_ns();
+        sink = lz_decompress((const uint8_t*)dst, packed, (uint8_t*)src + FS_CHUNK_SIZE, FS_CHUNK_SIZE);
+        samples[i] = now_ns() - t0;
+    }
+    report("lz_decompress", FS_CHUNK_SIZE);
+}
+
+int main(int argc, char** argv) {
+    hosted_verbose = argc > 1 && argv[1][0] == '-' && argv[1][1] == 'v';
+    printf("host,name,param,iters,min,median,p99\n");
+    bench_fs_find();
+    bench_strings();
+    if (!hosted_fs_consistent()) {
+        fprintf(stderr, "fs_host: file_count와 사용 중 슬롯 수가 다릅니다\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+/* hosted.h - 기억FS와 문자열 함수를 호스트 프로그램으로 빌드하기 위한 공통 부분 */
+/* kernel.c를 KERNEL_HOSTED로 그대로 포함하고, 커널이 쓰는 출력 함수를 제공한다.
+   하나의 번역 단위로 빌드하는 프로그램에서만 포함할 것. */
+#ifndef MIRAE_HOSTED_H
+#define MIRAE_HOSTED_H
+
+#define KERNEL_HOSTED
+#include "../src/kernel/kernel.c"
+
+#include <stdio.h>
+
+/* 0이면 커널 메시지를 버린다 (벤치마크/퍼징 시 출력 비용 제거) */
+int hosted_verbose = 0;
+
+void kprint(const char* str) {
+    if (hosted_verbose) fputs(str, stdout);
+}
+
+void kprintln(const char* str) {
+    if (hosted_verbose) puts(str);
+}
+
+void kprint_dec(int num) {
+    if (hosted_verbose) printf("%d", num);
+}
+
+/* 사용 중 슬롯 수와 file_count, 청크가 차지한 블록 수와 blocks_used가 일치하는지 확인 */
+static int hosted_fs_consistent(void) {
+    int used = 0, blocks = 0, marked = 0;
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (fs.files[i].used) used++;
+        for (int c = 0; c < FS_CHUNKS_PER_FILE; c++)
+            blocks += fs_blocks_for(fs.files[i].chunk_stored[c]);
+    }
+    for (int b = 0; b < FS_DATA_BLOCKS; b++) marked += fs.block_used[b];
+    return used == fs.file_count && fs.files[0].used &&
+           blocks == fs.blocks_used && marked == fs.blocks_used;
+}
+
+#endif /* MIRAE_HOSTED_H */
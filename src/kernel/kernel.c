@@ -1,14 +1,23 @@
 /* kernel.c - 미래 OS 통합 커널 예제 */
 /* 포함된 명령어: 
    cd, cd.., md, rm, pwd, ls/dir, cat, echo, clear, help, history,
-   shred, linkfile, touch, cp, mv, find, execbin, execelf
+   shred, linkfile, touch, cp, mv, find, grep, execbin, execelf, compress,
+   meminfo, elfcache, bench
 */
 
+/* KERNEL_HOSTED: 기억FS와 문자열 함수만 호스트 프로그램으로 빌드 (host/ 참고).
+   이때 kprint/kprintln/kprint_dec는 호스트 쪽에서 제공한다. */
+
 /* ======================= 기본 타입 및 문자열/메모리 함수 ======================= */
+#ifdef KERNEL_HOSTED
+#include <stddef.h>
+#include <stdint.h>
+#else
 typedef unsigned int   uint32_t;
 typedef unsigned short uint16_t;
 typedef unsigned char  uint8_t;
 typedef uint32_t       size_t;
+#endif
 
 size_t kstrlen(const char* s) {
     size_t len = 0;
@@ -71,11 +80,55 @@ int kstrcontains(const char* str, const char* substr) {
     return 0;
 }
 
+/* Horspool 검색: text[0..n)에서 pat[0..m)이 처음 나오는 위치, 없으면 -1 */
+int kmemsearch(const char* text, size_t n, const char* pat, size_t m) {
+    if (m == 0) return 0;
+    if (m > n) return -1;
+    size_t shift[256];
+    for (int i = 0; i < 256; i++) shift[i] = m;
+    for (size_t i = 0; i + 1 < m; i++) shift[(uint8_t)pat[i]] = m - 1 - i;
+    size_t pos = 0;
+    uint8_t last = (uint8_t)pat[m - 1];
+    while (pos + m <= n) {
+        uint8_t c = (uint8_t)text[pos + m - 1];
+        if (c == last) {
+            size_t j = 0;
+            while (j + 1 < m && text[pos + j] == pat[j]) j++;
+            if (j + 1 == m) return (int)pos;
+        }
+        pos += shift[c];
+    }
+    return -1;
+}
+
+/* 부호 없는 정수를 10진 문자열로 변환 (out은 최소 11바이트) */
+char* kutoa(uint32_t num, char* out) {
+    char tmp[11];
+    int i = 0;
+    do {
+        tmp[i++] = '0' + (num % 10);
+        num /= 10;
+    } while (num > 0);
+    int j = 0;
+    while (i > 0) out[j++] = tmp[--i];
+    out[j] = '\0';
+    return out;
+}
+
+#ifdef KERNEL_HOSTED
+void kprint(const char* str);
+void kprintln(const char* str);
+void kprint_dec(int num);
+#else
 /* ======================= VGA 출력 관련 ======================= */
 volatile uint16_t* vga_buffer = (uint16_t*)0xb8000;
 int vga_cursor = 0;  // 전체 화면 출력용 커서
 
+void serial_print(const char* str);
+
+/* 화면 출력은 시리얼 콘솔(COM1)에도 그대로 복사된다 */
 void kprint(const char* str) {
+    serial_print(str);
     for (int i = 0; str[i] != '\0'; i++) {
         char c = str[i];
         if (c == '\n')
@@ -126,6 +179,50 @@ static inline void outb(uint16_t port, uint8_t data) {
     asm volatile ("outb %0, %1" : : "a"(data), "Nd"(port));
 }
 
+/* ======================= 시리얼 포트 (COM1) ======================= */
+#define COM1_PORT 0x3F8
+
+void init_serial() {
+    outb(COM1_PORT + 1, 0x00);    /* 인터럽트 비활성화 */
+    outb(COM1_PORT + 3, 0x80);    /* DLAB 설정 */
+    outb(COM1_PORT + 0, 0x01);    /* 115200 baud */
+    outb(COM1_PORT + 1, 0x00);
+    outb(COM1_PORT + 3, 0x03);    /* 8N1 */
+    outb(COM1_PORT + 2, 0xC7);    /* FIFO 활성화 */
+    outb(COM1_PORT + 4, 0x0B);    /* DTR/RTS, OUT2 (IRQ4 사용) */
+    outb(COM1_PORT + 1, 0x01);    /* 수신 데이터 인터럽트 */
+}
+
+void serial_putc(char c) {
+    while ((inb(COM1_PORT + 5) & 0x20) == 0) ;
+    outb(COM1_PORT, (uint8_t)c);
+}
+
+void serial_print(const char* str) {
+    for (int i = 0; str[i] != '\0'; i++) {
+        if (str[i] == '\n') serial_putc('\r');
+        serial_putc(str[i]);
+    }
+}
+
+void serial_print_dec(uint32_t num) {
+    char buffer[11];
+    serial_print(kutoa(num, buffer));
+}
+
+/* QEMU isa-debug-exit (iobase=0xf4): QEMU 종료 코드는 (code << 1) | 1 */
+void qemu_exit(uint8_t code) {
+    outb(0xF4, code);
+}
+
+/* ======================= 사이클 카운터 ======================= */
+/* TSC 하위 32비트만 사용: 구간 측정에는 뺄셈 오버플로가 그대로 맞는다 */
+static inline uint32_t rdtsc32() {
+    uint32_t lo, hi;
+    asm volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return lo;
+}
+
 /* ======================= CLI 관련 ======================= */
 #define CLI_BUFFER_SIZE 256
 char cli_buffer[CLI_BUFFER_SIZE] = {0};
@@ -160,6 +257,7 @@ void clear_screen() {
     vga_cursor = 0;
     update_cli_display();
 }
+#endif /* KERNEL_HOSTED */
 
 /* ======================= 간단 토큰화 함수 ======================= */
 int tokenize(char* input, char* tokens[], int max_tokens) {
@@ -179,29 +277,266 @@ int tokenize(char* input, char* tokens[], int max_tokens) {
     return count;
 }
 
+/* ======================= CPU별 통계 카운터 ======================= */
+/* 빈번한 경로에서 올리는 카운터는 CPU마다 따로 두어 공유 캐시 라인 경합과
+   락이 없도록 한다. 읽는 쪽(/proc)만 모든 CPU를 합산한다. 현재는 단일 CPU. */
+#define MAX_CPUS          1
+#define IRQ_LINES         16
+#define IRQ_HIST_BUCKETS  16    /* 버킷 i: 2^(i+6) ~ 2^(i+7) 사이클, 양 끝은 열린 구간 */
+#define MAX_BUILTINS      32
+
+typedef struct {
+    uint32_t irq_count[IRQ_LINES];
+    uint32_t irq_latency[IRQ_LINES][IRQ_HIST_BUCKETS];
+    uint32_t fs_find_hits;
+    uint32_t fs_find_misses;
+    uint32_t fs_cache_hits;      /* 압축 해제 청크 캐시 */
+    uint32_t fs_cache_misses;
+    uint32_t command_count[MAX_BUILTINS];
+} __attribute__((aligned(64))) CpuStats;
+
+CpuStats cpu_stats[MAX_CPUS];
+
+static inline CpuStats* this_cpu() {
+    return &cpu_stats[0];
+}
+
+/* ======================= LZ 압축 (LZ4 블록 형식) ======================= */
+/* 시퀀스: 토큰(상위 4비트 리터럴 길이, 하위 4비트 매치 길이-4), 확장 길이(255 단위),
+   리터럴, 2바이트 LE 오프셋, 확장 매치 길이. 마지막 시퀀스는 리터럴만 가진다. */
+#define LZ_MIN_MATCH     4
+#define LZ_LAST_LITERALS 5
+#define LZ_HASH_BITS     8
+
+static uint32_t lz_read32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* 시퀀스 하나를 기록하고 새 출력 위치 반환 (공간 부족 시 -1). match_len 0은 마지막 시퀀스 */
+static int lz_emit(uint8_t* dst, int cap, int op, const uint8_t* lit, int lit_len,
+                   int offset, int match_len) {
+    int ml = match_len ? match_len - LZ_MIN_MATCH : 0;
+    if (op >= cap) return -1;
+    dst[op++] = (uint8_t)(((lit_len < 15 ? lit_len : 15) << 4) | (ml < 15 ? ml : 15));
+    if (lit_len >= 15) {
+        int rest = lit_len - 15;
+        for (; rest >= 255; rest -= 255) {
+            if (op >= cap) return -1;
+            dst[op++] = 255;
+        }
+        if (op >= cap) return -1;
+        dst[op++] = (uint8_t)rest;
+    }
+    if (op + lit_len > cap) return -1;
+    kmemcpy(dst + op, lit, lit_len);
+    op += lit_len;
+    if (!match_len) return op;
+    if (op + 2 > cap) return -1;
+    dst[op++] = (uint8_t)(offset & 0xFF);
+    dst[op++] = (uint8_t)(offset >> 8);
+    if (ml >= 15) {
+        int rest = ml - 15;
+        for (; rest >= 255; rest -= 255) {
+            if (op >= cap) return -1;
+            dst[op++] = 255;
+        }
+        if (op >= cap) return -1;
+        dst[op++] = (uint8_t)rest;
+    }
+    return op;
+}
+
+/* src[0..n)을 압축해 dst에 기록. 결과가 cap 바이트를 넘으면 0 반환 (원본 저장) */
+int lz_compress(const uint8_t* src, int n, uint8_t* dst, int cap) {
+    uint16_t table[1 << LZ_HASH_BITS];    /* 위치 + 1, 0은 비어 있음 */
+    for (int i = 0; i < (1 << LZ_HASH_BITS); i++) table[i] = 0;
+    int ip = 0, anchor = 0, op = 0;
+    int limit = n - LZ_LAST_LITERALS;
+    while (ip + LZ_MIN_MATCH <= limit) {
+        uint32_t seq = lz_read32(src + ip);
+        uint32_t h = (seq * 2654435761u) >> (32 - LZ_HASH_BITS);
+        int ref = table[h] - 1;
+        table[h] = (uint16_t)(ip + 1);
+        if (ref < 0 || ip - ref > 0xFFFF || lz_read32(src + ref) != seq) {
+            ip++;
+            continue;
+        }
+        int len = LZ_MIN_MATCH;
+        while (ip + len < limit && src[ref + len] == src[ip + len]) len++;
+        op = lz_emit(dst, cap, op, src + anchor, ip - anchor, ip - ref, len);
+        if (op < 0) return 0;
+        ip += len;
+        anchor = ip;
+    }
+    op = lz_emit(dst, cap, op, src + anchor, n - anchor, 0, 0);
+    return op < 0 ? 0 : op;
+}
+
+/* 압축 해제: 출력 길이 반환, 손상된 입력이면 -1 */
+int lz_decompress(const uint8_t* src, int n, uint8_t* dst, int cap) {
+    int ip = 0, op = 0;
+    while (ip < n) {
+        int token = src[ip++];
+        int lit_len = token >> 4;
+        if (lit_len == 15) {
+            int b;
+            do {
+                if (ip >= n) return -1;
+                b = src[ip++];
+                lit_len += b;
+            } while (b == 255);
+        }
+        if (ip + lit_len > n || op + lit_len > cap) return -1;
+        kmemcpy(dst + op, src + ip, lit_len);
+        ip += lit_len;
+        op += lit_len;
+        if (ip == n) break;
+        if (ip + 2 > n) return -1;
+        int offset = src[ip] | (src[ip + 1] << 8);
+        ip += 2;
+        int match_len = (token & 0x0F) + LZ_MIN_MATCH;
+        if ((token & 0x0F) == 15) {
+            int b;
+            do {
+                if (ip >= n) return -1;
+                b = src[ip++];
+                match_len += b;
+            } while (b == 255);
+        }
+        if (offset == 0 || offset > op || op + match_len > cap) return -1;
+        for (int i = 0; i < match_len; i++, op++)    /* 겹치는 복사 허용 */
+            dst[op] = dst[op - offset];
+    }
+    return op;
+}
+
 /* ======================= 기억FS (간단한 계층형 파일 시스템) ======================= */
 #define MAX_FILES        10
 #define MAX_FILENAME_LEN 64
 #define MAX_FILE_SIZE    1024
 
+/* 파일 내용은 FS_CHUNK_SIZE 단위 청크로 나뉘어 공용 데이터 풀에 저장된다.
+   압축 파일의 청크는 LZ 압축 결과가 더 작을 때만 압축된 형태로 저장되므로
+   저장 길이가 원래 청크 길이와 같으면 원본 청크다. */
+#define FS_CHUNK_SIZE        256
+#define FS_CHUNKS_PER_FILE   (MAX_FILE_SIZE / FS_CHUNK_SIZE)
+#define FS_BLOCK_SIZE        32
+/* 데이터 풀 크기. 기본값은 모든 슬롯을 가득 채운 크기(MAX_FILES * MAX_FILE_SIZE)라
+   압축을 끈 파일과 압축되지 않는 내용도 이전과 같은 만큼 담긴다. 빌드할 때
+   -DFS_POOL_SIZE=...로 줄이면 압축이 되는 만큼만 더 담을 수 있고, 모자라면
+   쓰기가 실패로 보고된다. FS_BLOCK_SIZE의 배수여야 한다. */
+#ifndef FS_POOL_SIZE
+#define FS_POOL_SIZE         (MAX_FILES * MAX_FILE_SIZE)
+#endif
+#define FS_DATA_BLOCKS       (FS_POOL_SIZE / FS_BLOCK_SIZE)
+#define FS_CACHE_ENTRIES     4     /* 압축 해제된 청크 캐시 */
+/* 파일 내용에 실제로 잡힌 메모리(풀 + 청크 캐시)와 슬롯마다 고정 버퍼를 두던 배치의 크기 */
+#define FS_RESERVED_BYTES    (FS_POOL_SIZE + FS_CACHE_ENTRIES * FS_CHUNK_SIZE)
+#define FS_FLAT_BYTES        (MAX_FILES * MAX_FILE_SIZE)
+#define FS_COMPRESS_DEFAULT  1     /* 새 파일의 압축 여부 */
+
+typedef char fs_pool_fits_blocks[FS_POOL_SIZE % FS_BLOCK_SIZE == 0 &&
+                                 FS_POOL_SIZE / FS_BLOCK_SIZE <= 65536 ? 1 : -1];
+
 typedef struct {
     char name[MAX_FILENAME_LEN];  /* 전체 경로 (예: "/dir/file.txt") */
-    char content[MAX_FILE_SIZE];
     size_t size;
     int used;
     int is_directory;  /* 0: 파일, 1: 디렉토리 */
+    int compressed;    /* 1: 청크를 압축해서 저장 */
+    uint32_t generation;    /* 생성/쓰기/이동/삭제마다 새 값 (실행 이미지 캐시 무효화용) */
+    uint32_t content_hash;  /* 내용의 FNV-1a 해시 */
+    uint16_t chunk_block[FS_CHUNKS_PER_FILE];   /* 데이터 풀 시작 블록 */
+    uint16_t chunk_stored[FS_CHUNKS_PER_FILE];  /* 저장된 바이트 수 */
 } File;
 
 typedef struct {
     File files[MAX_FILES];
     int file_count;
+    char data[FS_DATA_BLOCKS * FS_BLOCK_SIZE];
+    uint8_t block_used[FS_DATA_BLOCKS];
+    int blocks_used;
 } MemoryFS;
 
+typedef struct {
+    int file;          /* -1: 비어 있음 */
+    int chunk;
+    uint32_t last_use;
+    char data[FS_CHUNK_SIZE];
+} ChunkCacheEntry;
+
 MemoryFS fs;
 char current_directory[256] = "/";
+uint32_t fs_generation = 0;
+
+ChunkCacheEntry fs_cache[FS_CACHE_ENTRIES];
+/* 파일 내용을 통째로 풀어 놓는 유일한 작업 버퍼 (cat/execbin/execelf, 압축 전환).
+   shred가 지울 수 있도록 평문 사본은 이 버퍼와 청크 캐시에만 둔다 */
+char file_buffer[MAX_FILE_SIZE + 1];
+/* 파일이 삭제(shred 포함)된 뒤 불리는 훅. 파일 내용의 사본을 따로 보관하는
+   커널 부분(실행 이미지 캐시)이 등록해 그 사본을 지운다 */
+void (*fs_delete_hook)(int idx) = 0;
+uint32_t fs_cache_clock = 0;
+
+/* ----- 트라이그램 색인 ----- */
+/* 이름과 내용 각각에 대해, 해시된 트라이그램 버킷마다 그 트라이그램을 가진
+   파일 슬롯의 비트마스크를 둔다. 검색은 패턴의 트라이그램 버킷을 AND해서
+   후보를 좁히고, 해시 충돌로 생긴 거짓 후보는 kmemsearch로 걸러낸다.
+   제거할 때는 그 파일의 이름/내용 트라이그램 버킷에서만 비트를 지운다. */
+#define FS_TRIGRAM_BITS    10
+#define FS_TRIGRAM_BUCKETS (1 << FS_TRIGRAM_BITS)
+
+typedef uint16_t fs_mask_t;    /* 파일 슬롯 비트마스크 */
+typedef char fs_mask_fits_slots[MAX_FILES <= 16 ? 1 : -1];
+
+fs_mask_t fs_name_index[FS_TRIGRAM_BUCKETS];
+fs_mask_t fs_content_index[FS_TRIGRAM_BUCKETS];
+
+static uint32_t fs_trigram_bucket(const char* p) {
+    uint32_t t = ((uint8_t)p[0] << 16) | ((uint8_t)p[1] << 8) | (uint8_t)p[2];
+    return (t * 2654435761u) >> (32 - FS_TRIGRAM_BITS);
+}
+
+static void fs_index_add(fs_mask_t* index, int idx, const char* text, size_t len) {
+    for (size_t i = 0; i + 3 <= len; i++)
+        index[fs_trigram_bucket(text + i)] |= 1u << idx;
+}
+
+/* text는 fs_index_add에 넘겼던 것과 같아야 한다 */
+static void fs_index_remove(fs_mask_t* index, int idx, const char* text, size_t len) {
+    fs_mask_t keep = (fs_mask_t)~(1u << idx);
+    for (size_t i = 0; i + 3 <= len; i++)
+        index[fs_trigram_bucket(text + i)] &= keep;
+}
+
+static fs_mask_t fs_used_mask() {
+    fs_mask_t mask = 0;
+    for (int i = 0; i < MAX_FILES; i++)
+        if (fs.files[i].used) mask |= 1u << i;
+    return mask;
+}
+
+/* 패턴을 포함할 수 있는 파일 슬롯 후보. 3글자 미만이면 모든 사용 중 슬롯 */
+fs_mask_t fs_index_candidates(const fs_mask_t* index, const char* pat, size_t m) {
+    fs_mask_t mask = fs_used_mask();
+    for (size_t i = 0; i + 3 <= m && mask; i++)
+        mask &= index[fs_trigram_bucket(pat + i)];
+    return mask;
+}
 
 void init_fs() {
-    for (int i = 0; i < MAX_FILES; i++) fs.files[i].used = 0;
+    for (int b = 0; b < FS_TRIGRAM_BUCKETS; b++) {
+        fs_name_index[b] = 0;
+        fs_content_index[b] = 0;
+    }
+    for (int i = 0; i < MAX_FILES; i++) {
+        fs.files[i].used = 0;
+        fs.files[i].size = 0;
+        for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) fs.files[i].chunk_stored[c] = 0;
+    }
+    for (int b = 0; b < FS_DATA_BLOCKS; b++) fs.block_used[b] = 0;
+    fs.blocks_used = 0;
+    for (int e = 0; e < FS_CACHE_ENTRIES; e++) fs_cache[e].file = -1;
     fs.file_count = 0;
     /* 루트 디렉토리 생성 */
     fs.files[0].used = 1;
@@ -209,13 +544,361 @@ void init_fs() {
     kstrncpy(fs.files[0].name, "/", MAX_FILENAME_LEN);
     fs.files[0].size = 0;
     fs.file_count = 1;
+    fs_index_add(fs_name_index, 0, fs.files[0].name, kstrlen(fs.files[0].name));
+}
+
+/* ----- 청크 저장소 ----- */
+uint32_t fs_hash(const char* data, size_t size) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        h ^= (uint8_t)data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int fs_chunk_length(const File* f, int chunk) {
+    int len = (int)f->size - chunk * FS_CHUNK_SIZE;
+    if (len <= 0) return 0;
+    return len < FS_CHUNK_SIZE ? len : FS_CHUNK_SIZE;
+}
+
+static int fs_blocks_for(int bytes) {
+    return (bytes + FS_BLOCK_SIZE - 1) / FS_BLOCK_SIZE;
+}
+
+/* 연속된 블록 count개를 first-fit으로 할당, 실패 시 -1 */
+static int fs_alloc_blocks(int count) {
+    int run = 0;
+    for (int b = 0; b < FS_DATA_BLOCKS; b++) {
+        run = fs.block_used[b] ? 0 : run + 1;
+        if (run == count) {
+            int start = b - count + 1;
+            for (int i = start; i <= b; i++) fs.block_used[i] = 1;
+            fs.blocks_used += count;
+            return start;
+        }
+    }
+    return -1;
+}
+
+/* 해제한 블록은 0으로 지워, 덮어쓴 옛 내용이 풀에 남지 않게 한다 */
+static void fs_free_blocks(int start, int count) {
+    for (int i = start * FS_BLOCK_SIZE; i < (start + count) * FS_BLOCK_SIZE; i++) fs.data[i] = 0;
+    for (int i = start; i < start + count; i++) fs.block_used[i] = 0;
+    fs.blocks_used -= count;
+}
+
+/* 파일의 캐시 항목을 버리고 풀어 둔 평문도 지운다 */
+void fs_cache_invalidate(int idx) {
+    for (int e = 0; e < FS_CACHE_ENTRIES; e++) {
+        if (fs_cache[e].file != idx) continue;
+        fs_cache[e].file = -1;
+        for (int i = 0; i < FS_CHUNK_SIZE; i++) fs_cache[e].data[i] = 0;
+    }
+}
+
+/* src에 저장된 내용의 트라이그램 버킷마다 내용 색인의 dst 비트를 켜거나(add)
+   끈다. 청크를 캐시를 거치지 않고 직접 풀며, 청크 경계의 트라이그램을 위해
+   앞 청크의 마지막 두 바이트를 이어 붙인다. 빈 파일은 할 일이 없다 */
+static void fs_index_content(int src, int dst, int add) {
+    const File* f = &fs.files[src];
+    char buf[FS_CHUNK_SIZE + 2];
+    int carry = 0;
+    for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) {
+        int len = fs_chunk_length(f, c);
+        if (len == 0) break;
+        const char* stored = fs.data + f->chunk_block[c] * FS_BLOCK_SIZE;
+        if (f->chunk_stored[c] == len)
+            kmemcpy(buf + carry, stored, len);
+        else
+            lz_decompress((const uint8_t*)stored, f->chunk_stored[c],
+                          (uint8_t*)buf + carry, FS_CHUNK_SIZE);
+        int n = carry + len;
+        if (add) fs_index_add(fs_content_index, dst, buf, n);
+        else fs_index_remove(fs_content_index, dst, buf, n);
+        carry = n < 2 ? n : 2;
+        for (int i = 0; i < carry; i++) buf[i] = buf[n - carry + i];
+    }
+}
+
+/* 파일 내용을 모두 해제 (크기 0) */
+void fs_release_content(int idx) {
+    File* f = &fs.files[idx];
+    fs_index_content(idx, idx, 0);
+    for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) {
+        if (f->chunk_stored[c]) {
+            fs_free_blocks(f->chunk_block[c], fs_blocks_for(f->chunk_stored[c]));
+            f->chunk_stored[c] = 0;
+        }
+    }
+    f->size = 0;
+    f->content_hash = fs_hash(0, 0);
+    f->generation = ++fs_generation;
+    fs_cache_invalidate(idx);
+}
+
+/* 설치된 청크를 풀 앞쪽으로 모아 빈 블록을 하나로 잇는다. 연속 블록을 찾지 못한
+   쓰기가 다시 시도하기 전에 부르며, 설치되지 않은 새 청크가 없을 때만 안전하다 */
+static void fs_compact() {
+    int next = 0;
+    for (;;) {
+        File* best = 0;
+        int best_chunk = 0;
+        for (int i = 0; i < MAX_FILES; i++) {
+            File* f = &fs.files[i];
+            for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) {
+                if (!f->chunk_stored[c] || f->chunk_block[c] < next) continue;
+                if (!best || f->chunk_block[c] < best->chunk_block[best_chunk]) {
+                    best = f;
+                    best_chunk = c;
+                }
+            }
+        }
+        if (!best) break;
+        int count = fs_blocks_for(best->chunk_stored[best_chunk]);
+        if (best->chunk_block[best_chunk] != next)
+            kmemcpy(fs.data + next * FS_BLOCK_SIZE,
+                    fs.data + best->chunk_block[best_chunk] * FS_BLOCK_SIZE,
+                    count * FS_BLOCK_SIZE);
+        best->chunk_block[best_chunk] = (uint16_t)next;
+        next += count;
+    }
+    for (int i = next * FS_BLOCK_SIZE; i < FS_DATA_BLOCKS * FS_BLOCK_SIZE; i++) fs.data[i] = 0;
+    for (int b = 0; b < FS_DATA_BLOCKS; b++) fs.block_used[b] = b < next;
+}
+
+/* 새로 할당한 청크들을 되돌림 (쓰기 실패 시) */
+static void fs_free_chunks(const uint16_t* block, const uint16_t* stored) {
+    for (int c = 0; c < FS_CHUNKS_PER_FILE; c++)
+        if (stored[c]) fs_free_blocks(block[c], fs_blocks_for(stored[c]));
+}
+
+/* 새 청크를 파일에 설치: 기존 내용을 해제한 뒤 청크 표와 크기를 바꾼다 */
+static void fs_install_chunks(int idx, const uint16_t* block, const uint16_t* stored,
+                              size_t size) {
+    File* f = &fs.files[idx];
+    fs_release_content(idx);
+    for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) {
+        f->chunk_block[c] = block[c];
+        f->chunk_stored[c] = stored[c];
+    }
+    f->size = size;
+}
+
+/* data[0..size)를 새 청크로 압축해 저장. 공간이 없으면 할당한 것을 되돌리고 -1 */
+static int fs_store_chunks(const File* f, const char* data, size_t size,
+                           uint16_t* block, uint16_t* stored_len) {
+    char packed[FS_CHUNK_SIZE];
+    for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) stored_len[c] = 0;
+    for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) {
+        int len = (int)size - c * FS_CHUNK_SIZE;
+        if (len > FS_CHUNK_SIZE) len = FS_CHUNK_SIZE;
+        if (len <= 0) break;
+        const char* src = data + c * FS_CHUNK_SIZE;
+        int stored = 0;
+        if (f->compressed)
+            stored = lz_compress((const uint8_t*)src, len, (uint8_t*)packed, len - 1);
+        if (stored == 0) stored = len;
+        int start = fs_alloc_blocks(fs_blocks_for(stored));
+        if (start < 0) {
+            fs_free_chunks(block, stored_len);
+            return -1;
+        }
+        kmemcpy(fs.data + start * FS_BLOCK_SIZE, stored == len ? src : packed, stored);
+        block[c] = (uint16_t)start;
+        stored_len[c] = (uint16_t)stored;
+    }
+    return 0;
+}
+
+/* 파일 내용을 data[0..size)로 교체. 새 청크를 모두 할당한 뒤에 기존 내용을
+   해제하므로, 저장 공간이 부족하면 -1을 반환하고 파일은 그대로 남는다.
+   연속 블록이 모자라면 풀을 한 번 압착하고 다시 시도한다 */
+int fs_write(int idx, const char* data, size_t size) {
+    File* f = &fs.files[idx];
+    uint16_t block[FS_CHUNKS_PER_FILE];
+    uint16_t stored_len[FS_CHUNKS_PER_FILE];
+    if (size > MAX_FILE_SIZE) size = MAX_FILE_SIZE;
+    if (fs_store_chunks(f, data, size, block, stored_len) < 0) {
+        fs_compact();
+        if (fs_store_chunks(f, data, size, block, stored_len) < 0) {
+            kprintln("기억FS 저장 공간 부족");
+            return -1;
+        }
+    }
+    fs_install_chunks(idx, block, stored_len, size);
+    f->content_hash = fs_hash(data, size);
+    fs_index_add(fs_content_index, idx, data, size);
+    return 0;
+}
+
+/* 청크의 원본 데이터 포인터. 압축된 청크는 캐시에 풀어서 돌려준다 */
+static const char* fs_chunk_data(int idx, int chunk) {
+    File* f = &fs.files[idx];
+    int len = fs_chunk_length(f, chunk);
+    const char* stored = fs.data + f->chunk_block[chunk] * FS_BLOCK_SIZE;
+    if (f->chunk_stored[chunk] == len) return stored;
+
+    int victim = 0;
+    for (int e = 0; e < FS_CACHE_ENTRIES; e++) {
+        if (fs_cache[e].file == idx && fs_cache[e].chunk == chunk) {
+            fs_cache[e].last_use = ++fs_cache_clock;
+            this_cpu()->fs_cache_hits++;
+            return fs_cache[e].data;
+        }
+        if (fs_cache[e].file == -1 ||
+            (fs_cache[victim].file != -1 && fs_cache[e].last_use < fs_cache[victim].last_use))
+            victim = e;
+    }
+    this_cpu()->fs_cache_misses++;
+    ChunkCacheEntry* entry = &fs_cache[victim];
+    lz_decompress((const uint8_t*)stored, f->chunk_stored[chunk],
+                  (uint8_t*)entry->data, FS_CHUNK_SIZE);
+    entry->file = idx;
+    entry->chunk = chunk;
+    entry->last_use = ++fs_cache_clock;
+    return entry->data;
+}
+
+/* offset부터 최대 len바이트를 읽어 읽은 바이트 수 반환. 필요한 청크만 푼다 */
+size_t fs_read(int idx, size_t offset, char* buf, size_t len) {
+    File* f = &fs.files[idx];
+    if (offset >= f->size) return 0;
+    if (len > f->size - offset) len = f->size - offset;
+    size_t done = 0;
+    while (done < len) {
+        size_t pos = offset + done;
+        int chunk = pos / FS_CHUNK_SIZE;
+        size_t in_chunk = pos % FS_CHUNK_SIZE;
+        size_t n = FS_CHUNK_SIZE - in_chunk;
+        if (n > len - done) n = len - done;
+        kmemcpy(buf + done, fs_chunk_data(idx, chunk) + in_chunk, n);
+        done += n;
+    }
+    return done;
+}
+
+/* s의 저장된 청크를 새 블록에 그대로 복사. 공간이 없으면 되돌리고 -1 */
+static int fs_clone_chunks(const File* s, uint16_t* block, uint16_t* stored_len) {
+    for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) stored_len[c] = 0;
+    for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) {
+        if (!s->chunk_stored[c]) continue;
+        int start = fs_alloc_blocks(fs_blocks_for(s->chunk_stored[c]));
+        if (start < 0) {
+            fs_free_chunks(block, stored_len);
+            return -1;
+        }
+        kmemcpy(fs.data + start * FS_BLOCK_SIZE,
+                fs.data + s->chunk_block[c] * FS_BLOCK_SIZE, s->chunk_stored[c]);
+        block[c] = (uint16_t)start;
+        stored_len[c] = s->chunk_stored[c];
+    }
+    return 0;
+}
+
+/* 저장된 청크를 그대로 복사 (재압축 없음). 실패하면 dst는 그대로 남는다 */
+int fs_copy_content(int dst, int src) {
+    File* d = &fs.files[dst];
+    File* s = &fs.files[src];
+    uint16_t block[FS_CHUNKS_PER_FILE];
+    uint16_t stored_len[FS_CHUNKS_PER_FILE];
+    if (fs_clone_chunks(s, block, stored_len) < 0) {
+        fs_compact();
+        if (fs_clone_chunks(s, block, stored_len) < 0) {
+            kprintln("기억FS 저장 공간 부족");
+            return -1;
+        }
+    }
+    fs_install_chunks(dst, block, stored_len, s->size);
+    d->compressed = s->compressed;
+    d->content_hash = s->content_hash;
+    fs_index_content(src, dst, 1);
+    return 0;
+}
+
+/* 압축 여부를 바꾸고 내용을 새 형식으로 다시 저장 */
+int fs_set_compression(int idx, int enable) {
+    File* f = &fs.files[idx];
+    if (f->compressed == enable) return 0;
+    size_t size = fs_read(idx, 0, file_buffer, f->size);
+    f->compressed = enable;
+    if (fs_write(idx, file_buffer, size) < 0) {
+        f->compressed = !enable;    /* 공간 부족: 기존 형식 그대로 유지 */
+        return -1;
+    }
+    return 0;
+}
+
+/* 파일이 데이터 풀에서 실제로 차지하는 바이트 수 */
+size_t fs_stored_size(int idx) {
+    size_t total = 0;
+    for (int c = 0; c < FS_CHUNKS_PER_FILE; c++) total += fs.files[idx].chunk_stored[c];
+    return total;
+}
+
+/* ----- /proc 가상 파일 ----- */
+/* /proc 아래 파일은 슬롯을 차지하지 않고, 읽을 때마다 생성 함수가 내용을 만든다.
+   커널이 proc_files에 표를 등록하며, 등록된 표가 없으면 /proc은 보이지 않는다. */
+#define PROC_DIR "/proc"
+
+typedef struct {
+    char* buf;
+    size_t cap;
+    size_t len;
+} ProcWriter;
+
+typedef struct {
+    const char* name;
+    void (*generate)(ProcWriter* w);
+} ProcFile;
+
+const ProcFile* proc_files = 0;
+int proc_file_count = 0;
+
+void proc_puts(ProcWriter* w, const char* str) {
+    for (int i = 0; str[i] && w->len < w->cap; i++) w->buf[w->len++] = str[i];
+}
+
+void proc_putu(ProcWriter* w, uint32_t num) {
+    char buffer[11];
+    proc_puts(w, kutoa(num, buffer));
+}
+
+/* 경로가 /proc 자체이거나 그 아래인지 */
+int proc_is_path(const char* path) {
+    int len = kstrlen(PROC_DIR);
+    /* kstrncmp는 짧은 쪽이 끝나면 같다고 보므로 길이를 먼저 확인 */
+    return proc_file_count > 0 && (int)kstrlen(path) >= len &&
+           kstrncmp(path, PROC_DIR, len) == 0 &&
+           (path[len] == '\0' || path[len] == '/');
+}
+
+/* "/proc/<name>"에 해당하는 가상 파일 번호, 없으면 -1 */
+int proc_lookup(const char* path) {
+    if (!proc_is_path(path)) return -1;
+    const char* name = path + kstrlen(PROC_DIR);
+    if (*name++ != '/') return -1;
+    for (int p = 0; p < proc_file_count; p++)
+        if (kstrcmp(proc_files[p].name, name) == 0) return p;
+    return -1;
+}
+
+/* 가상 파일 내용을 생성해 buf에 기록하고 길이 반환 */
+size_t proc_read(int p, char* buf, size_t cap) {
+    ProcWriter w = { buf, cap, 0 };
+    proc_files[p].generate(&w);
+    return w.len;
 }
 
 int fs_find(const char* path) {
     for (int i = 0; i < MAX_FILES; i++) {
-        if (fs.files[i].used && kstrcmp(fs.files[i].name, path) == 0)
+        if (fs.files[i].used && kstrcmp(fs.files[i].name, path) == 0) {
+            this_cpu()->fs_find_hits++;
             return i;
+        }
     }
+    this_cpu()->fs_find_misses++;
     return -1;
 }
 
@@ -235,6 +918,10 @@ void build_full_path(const char* relative, char* out, int out_size) {
 int fs_create_file(const char* name) {
     char full_path[MAX_FILENAME_LEN];
     build_full_path(name, full_path, MAX_FILENAME_LEN);
+    if (proc_is_path(full_path)) {
+       kprintln("/proc은 읽기 전용입니다.");
+       return -1;
+    }
     if (fs_find(full_path) != -1) {
        kprintln("파일이 이미 존재합니다.");
        return -1;
@@ -245,8 +932,11 @@ int fs_create_file(const char* name) {
             fs.files[i].is_directory = 0;
             kstrncpy(fs.files[i].name, full_path, MAX_FILENAME_LEN);
             fs.files[i].size = 0;
-            fs.files[i].content[0] = '\0';
+            fs.files[i].compressed = FS_COMPRESS_DEFAULT;
+            fs.files[i].content_hash = fs_hash(0, 0);
+            fs.files[i].generation = ++fs_generation;
             fs.file_count++;
+            fs_index_add(fs_name_index, i, fs.files[i].name, kstrlen(fs.files[i].name));
             return i;
         }
     }
@@ -258,6 +948,10 @@ int fs_create_file(const char* name) {
 int fs_create_directory(const char* name) {
     char full_path[MAX_FILENAME_LEN];
     build_full_path(name, full_path, MAX_FILENAME_LEN);
+    if (proc_is_path(full_path)) {
+       kprintln("/proc은 읽기 전용입니다.");
+       return -1;
+    }
     if (fs_find(full_path) != -1) {
        kprintln("디렉토리가 이미 존재합니다.");
        return -1;
@@ -269,6 +963,7 @@ int fs_create_directory(const char* name) {
             kstrncpy(fs.files[i].name, full_path, MAX_FILENAME_LEN);
             fs.files[i].size = 0;
             fs.file_count++;
+            fs_index_add(fs_name_index, i, fs.files[i].name, kstrlen(fs.files[i].name));
             return i;
         }
     }
@@ -295,8 +990,11 @@ int fs_delete(const char* path) {
          }
        }
     }
+    fs_release_content(idx);
+    fs_index_remove(fs_name_index, idx, fs.files[idx].name, kstrlen(fs.files[idx].name));
     fs.files[idx].used = 0;
     fs.file_count--;
+    if (fs_delete_hook) fs_delete_hook(idx);
     return 0;
 }
 
@@ -304,6 +1002,15 @@ int fs_delete(const char* path) {
 void fs_list_directory() {
     int current_len = kstrlen(current_directory);
     kprintln("=== Directory Listing ===");
+    if (proc_is_path(current_directory)) {
+        for (int p = 0; p < proc_file_count; p++) {
+            kprint(proc_files[p].name);
+            kprintln(" <PROC>");
+        }
+        return;
+    }
+    if (proc_file_count > 0 && kstrcmp(current_directory, "/") == 0)
+        kprintln("proc <DIR>");
     for (int i = 0; i < MAX_FILES; i++) {
         if (!fs.files[i].used) continue;
         if (kstrncmp(fs.files[i].name, current_directory, current_len) == 0) {
@@ -323,13 +1030,125 @@ void fs_list_directory() {
                 } else {
                     kprint(" ");
                     kprint_dec((int)fs.files[i].size);
-                    kprintln(" bytes");
+                    kprint(" bytes");
+                    if (fs.files[i].compressed && fs.files[i].size > 0) {
+                        size_t stored = fs_stored_size(i);
+                        kprint(" [z ");
+                        kprint_dec((int)stored);
+                        kprint(", ");
+                        kprint_dec((int)(stored * 100 / fs.files[i].size));
+                        kprint("%]");
+                    }
+                    kprintln("");
                 }
             }
         }
     }
 }
 
+/* meminfo: 슬롯, 데이터 풀, 전체 압축률, 청크 캐시 통계 */
+void fs_print_meminfo() {
+    size_t logical = 0, stored = 0;
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (!fs.files[i].used || fs.files[i].is_directory) continue;
+        logical += fs.files[i].size;
+        stored += fs_stored_size(i);
+    }
+    kprintln("=== Memory Info ===");
+    kprint("File slots: ");
+    kprint_dec(fs.file_count);
+    kprint(" / ");
+    kprint_dec(MAX_FILES);
+    kprintln("");
+    kprint("Data pool: ");
+    kprint_dec(fs.blocks_used * FS_BLOCK_SIZE);
+    kprint(" / ");
+    kprint_dec(FS_DATA_BLOCKS * FS_BLOCK_SIZE);
+    kprintln(" bytes");
+    kprint("Reserved: ");
+    kprint_dec(FS_RESERVED_BYTES);
+    kprint(" bytes (flat ");
+    kprint_dec(FS_FLAT_BYTES);
+    kprintln(")");
+    kprint("Content: ");
+    kprint_dec((int)logical);
+    kprint(" bytes, stored ");
+    kprint_dec((int)stored);
+    kprint(" bytes");
+    if (logical > 0) {
+        kprint(" (");
+        kprint_dec((int)(stored * 100 / logical));
+        kprint("%)");
+    }
+    kprintln("");
+    uint32_t hits = 0, misses = 0;
+    for (int c = 0; c < MAX_CPUS; c++) {
+        hits += cpu_stats[c].fs_cache_hits;
+        misses += cpu_stats[c].fs_cache_misses;
+    }
+    kprint("Chunk cache: ");
+    kprint_dec((int)hits);
+    kprint(" hits, ");
+    kprint_dec((int)misses);
+    kprintln(" misses");
+}
+
+/* find: 이름에 패턴이 들어 있는 파일/디렉토리 출력. 색인 후보만 확인한다 */
+int fs_find_pattern(const char* pattern) {
+    size_t m = kstrlen(pattern);
+    fs_mask_t mask = fs_index_candidates(fs_name_index, pattern, m);
+    int found = 0;
+    while (mask) {
+        int i = __builtin_ctz(mask);
+        mask &= mask - 1;
+        if (kmemsearch(fs.files[i].name, kstrlen(fs.files[i].name), pattern, m) >= 0) {
+            kprintln(fs.files[i].name);
+            found++;
+        }
+    }
+    for (int p = 0; p < proc_file_count; p++) {
+        char path[MAX_FILENAME_LEN];
+        kstrncpy(path, PROC_DIR "/", MAX_FILENAME_LEN);
+        kstrcat(path, proc_files[p].name);
+        if (kmemsearch(path, kstrlen(path), pattern, m) >= 0) {
+            kprintln(path);
+            found++;
+        }
+    }
+    return found;
+}
+
+/* grep: 내용에 패턴이 들어 있는 줄을 "<파일>: <줄>" 형식으로 출력 */
+int fs_grep(const char* pattern) {
+    static char text[MAX_FILE_SIZE];
+    char line[81];
+    size_t m = kstrlen(pattern);
+    fs_mask_t mask = fs_index_candidates(fs_content_index, pattern, m);
+    int found = 0;
+    while (mask) {
+        int i = __builtin_ctz(mask);
+        mask &= mask - 1;
+        if (fs.files[i].is_directory) continue;
+        size_t n = fs_read(i, 0, text, fs.files[i].size);
+        size_t pos = 0;
+        int hit;
+        while (pos < n && (hit = kmemsearch(text + pos, n - pos, pattern, m)) >= 0) {
+            size_t start = pos + hit, end = start;
+            while (start > 0 && text[start - 1] != '\n') start--;
+            while (end < n && text[end] != '\n') end++;
+            size_t len = end - start < sizeof(line) - 1 ? end - start : sizeof(line) - 1;
+            kmemcpy(line, text + start, len);
+            line[len] = '\0';
+            kprint(fs.files[i].name);
+            kprint(": ");
+            kprintln(line);
+            found++;
+            pos = end + 1;
+        }
+    }
+    return found;
+}
+
 /* 디렉토리 변경: ".."는 상위, 그 외는 하위 디렉토리 이동 */
 int fs_change_directory(const char* path) {
     if (kstrcmp(path, "..") == 0) {
@@ -338,7 +1157,7 @@ int fs_change_directory(const char* path) {
             return -1;
         }
         int len = kstrlen(current_directory);
-        if (current_directory[len-1] == '/') current_directory[len-1] = '\0';
+        if (len > 1 && current_directory[len-1] == '/') current_directory[len-1] = '\0';
         int i;
         for (i = len - 1; i >= 0; i--) {
             if (current_directory[i] == '/') break;
@@ -360,6 +1179,10 @@ int fs_change_directory(const char* path) {
            kstrcat(new_path, "/");
            kstrcat(new_path, path);
        }
+       if (proc_file_count > 0 && kstrcmp(new_path, PROC_DIR) == 0) {
+           kstrncpy(current_directory, new_path, 256);
+           return 0;
+       }
        int idx = fs_find(new_path);
        if (idx == -1 || !fs.files[idx].is_directory) {
            kprintln("디렉토리가 존재하지 않습니다.");
@@ -387,8 +1210,10 @@ int fs_copy_file(const char* source, const char* destination) {
     }
     int new_idx = fs_create_file(destination);
     if (new_idx < 0) return -1;
-    kmemcpy(fs.files[new_idx].content, fs.files[src_idx].content, fs.files[src_idx].size);
-    fs.files[new_idx].size = fs.files[src_idx].size;
+    if (fs_copy_content(new_idx, src_idx) < 0) {
+        fs_delete(dest_full);
+        return -1;
+    }
     return 0;
 }
 
@@ -403,11 +1228,18 @@ int fs_move_file(const char* source, const char* destination) {
     }
     char dest_full[MAX_FILENAME_LEN];
     build_full_path(destination, dest_full, MAX_FILENAME_LEN);
+    if (proc_is_path(dest_full)) {
+        kprintln("/proc은 읽기 전용입니다.");
+        return -1;
+    }
     if (fs_find(dest_full) != -1) {
         kprintln("대상 파일/디렉토리가 이미 존재합니다.");
         return -1;
     }
+    fs_index_remove(fs_name_index, src_idx, fs.files[src_idx].name, kstrlen(fs.files[src_idx].name));
     kstrncpy(fs.files[src_idx].name, dest_full, MAX_FILENAME_LEN);
+    fs.files[src_idx].generation = ++fs_generation;
+    fs_index_add(fs_name_index, src_idx, fs.files[src_idx].name, kstrlen(fs.files[src_idx].name));
     return 0;
 }
 
@@ -431,8 +1263,13 @@ int fs_link_file(const char* source, const char* linkname) {
     }
     int link_idx = fs_create_file(linkname);
     if (link_idx < 0) return -1;
-    kmemcpy(fs.files[link_idx].content, fs.files[src_idx].content, fs.files[src_idx].size);
-    fs.files[link_idx].size = fs.files[src_idx].size;
+    if (fs_copy_content(link_idx, src_idx) < 0) {
+        fs_index_remove(fs_name_index, link_idx, fs.files[link_idx].name,
+                        kstrlen(fs.files[link_idx].name));
+        fs.files[link_idx].used = 0;
+        fs.file_count--;
+        return -1;
+    }
     return 0;
 }
 
@@ -445,13 +1282,18 @@ int fs_shred_file(const char* name) {
        kprintln("파일이 존재하지 않거나 디렉토리입니다.");
        return -1;
     }
-    for (int i = 0; i < fs.files[idx].size; i++)
-        fs.files[idx].content[i] = 0;
+    /* 풀 블록과 청크 캐시는 삭제하면서 해제될 때 지워진다. 작업 버퍼에 풀어
+       둔 평문 사본은 여기서 지운다 */
+    for (int i = 0; i < MAX_FILE_SIZE + 1; i++) file_buffer[i] = 0;
     return fs_delete(full_path);
 }
 
+#ifndef KERNEL_HOSTED
 /* ======================= ELF 로더 및 Raw binary 실행 ======================= */
 #define PT_LOAD 1
+#define PF_X    1
+#define PF_W    2
+#define PF_R    4
 
 typedef struct {
     unsigned char e_ident[16];
@@ -481,11 +1323,14 @@ typedef struct {
     uint32_t p_align;
 } Elf32_Phdr;
 
-/* ELF 파일 로더: loadable 세그먼트를 메모리로 복사한 후 엔트리 포인트로 점프 */
-void exec_elf(char* elf_data, size_t size) {
+/* 마지막으로 메모리에 올라간 캐시 이미지 (-1: 없음 또는 다른 코드가 덮어씀) */
+int elf_resident = -1;
+
+/* ELF 로드: loadable 세그먼트를 메모리로 복사하고 엔트리 주소 반환 (실패 시 0) */
+uint32_t elf_load(char* elf_data, size_t size) {
     if (size < sizeof(Elf32_Ehdr)) {
         kprintln("ELF 파일 크기가 너무 작습니다.");
-        return;
+        return 0;
     }
     Elf32_Ehdr* header = (Elf32_Ehdr*)elf_data;
     if (!(header->e_ident[0] == 0x7F &&
@@ -493,7 +1338,7 @@ void exec_elf(char* elf_data, size_t size) {
           header->e_ident[2] == 'L' &&
           header->e_ident[3] == 'F')) {
         kprintln("유효한 ELF 파일이 아닙니다.");
-        return;
+        return 0;
     }
     Elf32_Phdr* phdr = (Elf32_Phdr*)(elf_data + header->e_phoff);
     for (int i = 0; i < header->e_phnum; i++) {
@@ -505,10 +1350,18 @@ void exec_elf(char* elf_data, size_t size) {
             }
         }
     }
+    elf_resident = -1;
+    return header->e_entry;
+}
+
+/* ELF 파일 로더: loadable 세그먼트를 메모리로 복사한 후 엔트리 포인트로 점프 */
+void exec_elf(char* elf_data, size_t size) {
+    uint32_t entry_addr = elf_load(elf_data, size);
+    if (entry_addr == 0) return;
     kprint("Jumping to ELF entry point: ");
-    kprint_dec(header->e_entry);
+    kprint_dec(entry_addr);
     kprintln("");
-    void (*entry)() = (void (*)())header->e_entry;
+    void (*entry)() = (void (*)())entry_addr;
     entry();
 }
 
@@ -516,6 +1369,7 @@ void exec_elf(char* elf_data, size_t size) {
 void exec_bin(char* bin, size_t size) {
     char* exec_addr = (char*)0x200000;
     kmemcpy(exec_addr, bin, size);
+    elf_resident = -1;
     kprint("Jumping to raw binary at: ");
     kprint_dec((int)exec_addr);
     kprintln("");
@@ -523,11 +1377,620 @@ void exec_bin(char* bin, size_t size) {
     entry();
 }
 
+/* ======================= 실행 이미지 캐시 (execelf) ======================= */
+/* 파일 슬롯 + 세대 + 내용 해시로 찾는 준비된 ELF 이미지. 헤더 검증과 프로그램 헤더
+   분석은 처음 한 번만 하고, 세그먼트의 파일 내용은 원본 그대로 보관한다.
+   같은 이미지가 아직 메모리에 있으면 쓰기 가능 세그먼트와 .bss만 되돌리고,
+   그 사이 다른 이미지가 올라갔다면 보관한 사본에서 모든 세그먼트를 복사한다.
+   파일이 쓰기/이동/삭제되면 세대가 바뀌어 해당 항목은 무효가 된다. */
+#define ELF_CACHE_ENTRIES      4
+#define ELF_CACHE_MAX_SEGMENTS 8
+
+typedef struct {
+    uint32_t vaddr;
+    uint32_t filesz;
+    uint32_t memsz;
+    uint32_t flags;
+    uint32_t image_offset;    /* image[] 안의 원본 위치 */
+} ElfSegment;
+
+typedef struct {
+    int file;                 /* -1: 비어 있음 */
+    uint32_t generation;
+    uint32_t content_hash;
+    uint32_t entry;
+    uint32_t last_use;
+    int segment_count;
+    ElfSegment segments[ELF_CACHE_MAX_SEGMENTS];
+    char image[MAX_FILE_SIZE];
+} ElfImage;
+
+ElfImage elf_cache[ELF_CACHE_ENTRIES];
+uint32_t elf_cache_clock = 0;
+uint32_t elf_cache_hits = 0;
+uint32_t elf_cache_misses = 0;
+uint32_t elf_cold_cycles = 0;       /* 마지막 캐시 미스 실행의 로드 시간 */
+uint32_t elf_relaunch_cycles = 0;   /* 마지막 캐시 적중 실행의 로드 시간 */
+
+/* 캐시 항목을 비우고 보관하던 이미지 사본도 지운다 */
+void elf_cache_drop(int e) {
+    for (int i = 0; i < MAX_FILE_SIZE; i++) elf_cache[e].image[i] = 0;
+    elf_cache[e].file = -1;
+    elf_cache[e].segment_count = 0;
+    if (elf_resident == e) elf_resident = -1;
+}
+
+/* 파일이 삭제(shred 포함)될 때 그 파일의 이미지를 캐시에서 지운다 */
+void elf_cache_forget(int idx) {
+    for (int e = 0; e < ELF_CACHE_ENTRIES; e++)
+        if (elf_cache[e].file == idx) elf_cache_drop(e);
+}
+
+void init_elf_cache() {
+    for (int e = 0; e < ELF_CACHE_ENTRIES; e++) elf_cache[e].file = -1;
+    fs_delete_hook = elf_cache_forget;
+}
+
+/* 유효한 캐시 항목 번호, 없으면 -1. 세대가 바뀐 항목은 여기서 비운다 */
+int elf_cache_lookup(int idx) {
+    File* f = &fs.files[idx];
+    for (int e = 0; e < ELF_CACHE_ENTRIES; e++) {
+        if (elf_cache[e].file != idx) continue;
+        if (elf_cache[e].generation == f->generation &&
+            elf_cache[e].content_hash == f->content_hash) {
+            elf_cache[e].last_use = ++elf_cache_clock;
+            return e;
+        }
+        elf_cache_drop(e);
+    }
+    return -1;
+}
+
+/* 검증과 세그먼트 분석 후 캐시에 저장. 캐시할 수 없는 파일이면 -1 */
+int elf_cache_prepare(int idx, char* elf_data, size_t size) {
+    if (size < sizeof(Elf32_Ehdr)) return -1;
+    Elf32_Ehdr* header = (Elf32_Ehdr*)elf_data;
+    if (!(header->e_ident[0] == 0x7F &&
+          header->e_ident[1] == 'E' &&
+          header->e_ident[2] == 'L' &&
+          header->e_ident[3] == 'F'))
+        return -1;
+    if (header->e_phoff > size ||
+        header->e_phnum > (size - header->e_phoff) / sizeof(Elf32_Phdr))
+        return -1;
+
+    /* 세그먼트를 모두 검증한 뒤에야 희생 항목을 고른다: 캐시할 수 없는
+       파일이 멀쩡한 캐시 항목을 밀어내지 않도록 */
+    Elf32_Phdr* phdr = (Elf32_Phdr*)(elf_data + header->e_phoff);
+    uint32_t used = 0;
+    int segments = 0;
+    for (int i = 0; i < header->e_phnum; i++) {
+        if (phdr[i].p_type != PT_LOAD) continue;
+        if (segments == ELF_CACHE_MAX_SEGMENTS ||
+            phdr[i].p_offset > size || phdr[i].p_filesz > size - phdr[i].p_offset ||
+            phdr[i].p_filesz > MAX_FILE_SIZE - used)
+            return -1;
+        segments++;
+        used += phdr[i].p_filesz;
+    }
+
+    int victim = 0;
+    for (int e = 0; e < ELF_CACHE_ENTRIES; e++) {
+        if (elf_cache[e].file == -1) { victim = e; break; }
+        if (elf_cache[e].last_use < elf_cache[victim].last_use) victim = e;
+    }
+    ElfImage* img = &elf_cache[victim];
+    if (elf_resident == victim) elf_resident = -1;
+    img->segment_count = 0;
+    used = 0;
+    for (int i = 0; i < header->e_phnum; i++) {
+        if (phdr[i].p_type != PT_LOAD) continue;
+        ElfSegment* seg = &img->segments[img->segment_count++];
+        seg->vaddr = phdr[i].p_vaddr;
+        seg->filesz = phdr[i].p_filesz;
+        seg->memsz = phdr[i].p_memsz;
+        seg->flags = phdr[i].p_flags;
+        seg->image_offset = used;
+        kmemcpy(img->image + used, elf_data + phdr[i].p_offset, phdr[i].p_filesz);
+        used += phdr[i].p_filesz;
+    }
+    img->entry = header->e_entry;
+    img->generation = fs.files[idx].generation;
+    img->content_hash = fs.files[idx].content_hash;
+    img->last_use = ++elf_cache_clock;
+    img->file = idx;
+    return victim;
+}
+
+/* 캐시된 이미지를 메모리에 올리고 엔트리 주소 반환 */
+uint32_t elf_cache_launch(int e) {
+    ElfImage* img = &elf_cache[e];
+    int resident = (elf_resident == e);
+    for (int i = 0; i < img->segment_count; i++) {
+        ElfSegment* seg = &img->segments[i];
+        if (resident && !(seg->flags & PF_W)) continue;
+        kmemcpy((void*)seg->vaddr, img->image + seg->image_offset, seg->filesz);
+        for (uint32_t j = seg->filesz; j < seg->memsz; j++)
+            ((char*)seg->vaddr)[j] = 0;
+    }
+    elf_resident = e;
+    return img->entry;
+}
+
+/* 기억FS 파일 로드: 캐시에 있으면 재실행 준비만, 없으면 읽어서 준비한다.
+   엔트리 주소 반환 (실패 시 0) */
+uint32_t elf_file_load(int idx) {
+    uint32_t t0 = rdtsc32();
+    int e = elf_cache_lookup(idx);
+    int hit = (e >= 0);
+    if (!hit) {
+        size_t n = fs_read(idx, 0, file_buffer, fs.files[idx].size);
+        e = elf_cache_prepare(idx, file_buffer, n);
+        if (e < 0)    /* 캐시할 수 없는 파일은 기존 로더가 처리 (오류 메시지 포함) */
+            return elf_load(file_buffer, n);
+    }
+    uint32_t entry_addr = elf_cache_launch(e);
+    uint32_t cycles = rdtsc32() - t0;
+    if (hit) {
+        elf_cache_hits++;
+        elf_relaunch_cycles = cycles;
+    } else {
+        elf_cache_misses++;
+        elf_cold_cycles = cycles;
+    }
+    return entry_addr;
+}
+
+void exec_elf_file(int idx) {
+    uint32_t entry_addr = elf_file_load(idx);
+    if (entry_addr == 0) return;
+    kprint("Jumping to ELF entry point: ");
+    kprint_dec(entry_addr);
+    kprintln("");
+    void (*entry)() = (void (*)())entry_addr;
+    entry();
+}
+
+void elf_cache_print_stats() {
+    kprint("ELF cache: ");
+    kprint_dec((int)elf_cache_hits);
+    kprint(" hits, ");
+    kprint_dec((int)elf_cache_misses);
+    kprintln(" misses");
+    kprint("Last cold load: ");
+    kprint_dec((int)elf_cold_cycles);
+    kprint(" cycles, last relaunch: ");
+    kprint_dec((int)elf_relaunch_cycles);
+    kprintln(" cycles");
+}
+
 /* ======================= 명령어 히스토리 ======================= */
 #define MAX_HISTORY 10
 char command_history[MAX_HISTORY][CLI_BUFFER_SIZE];
 int history_count = 0;
 
+/* ======================= 마이크로벤치마크 (bench) ======================= */
+/* 각 항목을 BENCH_ITERS번 측정하여 min / median / p99 사이클을 보고한다.
+   화면에는 요약, COM1에는 "bench,<name>,<param>,<iters>,<min>,<median>,<p99>" 형식 */
+#define BENCH_ITERS     128
+#define BENCH_ELF_VADDR 0x400000
+#define BENCH_ELF_FILESZ 512     /* 코드 절반 + 데이터 절반 */
+#define BENCH_ELF_MEMSZ  1024    /* 데이터 세그먼트 뒤 512바이트는 .bss */
+
+void process_keyboard(uint8_t scancode);
+
+uint32_t bench_samples[BENCH_ITERS];
+volatile int bench_sink;    /* 결과를 버리는 호출이 최적화로 사라지지 않도록 */
+char bench_src[4096];
+char bench_dst[4096];
+char bench_elf[sizeof(Elf32_Ehdr) + 2 * sizeof(Elf32_Phdr) + BENCH_ELF_FILESZ];
+
+void bench_report(const char* name, uint32_t param) {
+    /* 삽입 정렬 (샘플 수가 작다) */
+    for (int i = 1; i < BENCH_ITERS; i++) {
+        uint32_t v = bench_samples[i];
+        int j = i - 1;
+        while (j >= 0 && bench_samples[j] > v) {
+            bench_samples[j+1] = bench_samples[j];
+            j--;
+        }
+        bench_samples[j+1] = v;
+    }
+    uint32_t min = bench_samples[0];
+    uint32_t median = bench_samples[BENCH_ITERS / 2];
+    uint32_t p99 = bench_samples[(BENCH_ITERS * 99 + 99) / 100 - 1];
+
+    char buf[11];
+    kprint(name);
+    kprint(" ");
+    kprint(kutoa(param, buf));
+    kprint(": min ");
+    kprint(kutoa(min, buf));
+    kprint(" med ");
+    kprint(kutoa(median, buf));
+    kprint(" p99 ");
+    kprintln(kutoa(p99, buf));
+
+    serial_print("bench,");
+    serial_print(name);
+    serial_print(",");
+    serial_print_dec(param);
+    serial_print(",");
+    serial_print_dec(BENCH_ITERS);
+    serial_print(",");
+    serial_print_dec(min);
+    serial_print(",");
+    serial_print_dec(median);
+    serial_print(",");
+    serial_print_dec(p99);
+    serial_print("\n");
+}
+
+/* 벤치마크용 파일 이름: ".bench<n>" */
+void bench_name(char* out, int n) {
+    char buf[11];
+    kstrncpy(out, ".bench", MAX_FILENAME_LEN);
+    kstrcat(out, kutoa((uint32_t)n, buf));
+}
+
+/* 사용 중인 슬롯이 target개가 될 때까지 벤치마크 파일 생성, 생성한 개수 반환 */
+int bench_fill(int target, int created) {
+    char name[MAX_FILENAME_LEN];
+    while (fs.file_count < target) {
+        bench_name(name, created);
+        if (fs_create_file(name) < 0) break;
+        created++;
+    }
+    return created;
+}
+
+void bench_cleanup(int created) {
+    char name[MAX_FILENAME_LEN];
+    char full_path[MAX_FILENAME_LEN];
+    for (int n = 0; n < created; n++) {
+        bench_name(name, n);
+        build_full_path(name, full_path, MAX_FILENAME_LEN);
+        fs_delete(full_path);
+    }
+}
+
+void bench_fs() {
+    static const int counts[] = { 1, MAX_FILES / 4, MAX_FILES / 2, MAX_FILES };
+    int created = 0;
+    for (int c = 0; c < (int)(sizeof(counts) / sizeof(counts[0])); c++) {
+        if (fs.file_count > counts[c]) continue;
+        created = bench_fill(counts[c], created);
+        /* 존재하지 않는 경로: 항상 전체 슬롯을 훑는 최악의 경우 */
+        for (int i = 0; i < BENCH_ITERS; i++) {
+            uint32_t t0 = rdtsc32();
+            bench_sink = fs_find("/.bench-missing");
+            bench_samples[i] = rdtsc32() - t0;
+        }
+        bench_report("fs_find", (uint32_t)fs.file_count);
+    }
+    bench_cleanup(created);
+
+    if (fs.file_count >= MAX_FILES) {
+        kprintln("fs_churn: 빈 슬롯이 없어 건너뜁니다.");
+        return;
+    }
+    char name[MAX_FILENAME_LEN];
+    char full_path[MAX_FILENAME_LEN];
+    bench_name(name, 0);
+    build_full_path(name, full_path, MAX_FILENAME_LEN);
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        fs_create_file(name);
+        fs_delete(full_path);
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("fs_churn", (uint32_t)fs.file_count);
+}
+
+void bench_strings() {
+    static const uint32_t sizes[] = { 16, 64, 256, 1024, 4096 };
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        for (int i = 0; i < BENCH_ITERS; i++) {
+            uint32_t t0 = rdtsc32();
+            kmemcpy(bench_dst, bench_src, sizes[s]);
+            bench_samples[i] = rdtsc32() - t0;
+        }
+        bench_report("kmemcpy", sizes[s]);
+    }
+
+    /* 최대 길이 경로 이름 두 개: 마지막 글자만 다르다 */
+    char a[MAX_FILENAME_LEN];
+    char b[MAX_FILENAME_LEN];
+    for (int i = 0; i < MAX_FILENAME_LEN - 1; i++) a[i] = b[i] = 'a' + (i % 26);
+    a[MAX_FILENAME_LEN - 1] = b[MAX_FILENAME_LEN - 1] = '\0';
+    b[MAX_FILENAME_LEN - 2] = '#';
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        bench_sink = kstrcmp(a, b);
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("kstrcmp", MAX_FILENAME_LEN - 1);
+
+    /* 없는 패턴: 모든 시작 위치를 확인 */
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        bench_sink = kstrcontains(a, "abcdx");
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("kstrcontains", MAX_FILENAME_LEN - 1);
+
+    /* 1KB 내용에서 없는 패턴 검색 (Horspool) */
+    for (int i = 0; i < MAX_FILE_SIZE; i++) bench_src[i] = 'a' + (i % 26);
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        bench_sink = kmemsearch(bench_src, MAX_FILE_SIZE, "abcdx", 5);
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("kmemsearch", MAX_FILE_SIZE);
+
+    /* 청크 하나 분량의 텍스트 압축/해제 */
+    static const char text[] = "the quick brown fox jumps over the lazy dog. ";
+    for (int i = 0; i < FS_CHUNK_SIZE; i++) bench_src[i] = text[i % (sizeof(text) - 1)];
+    int packed = 0;
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        packed = lz_compress((const uint8_t*)bench_src, FS_CHUNK_SIZE,
+                             (uint8_t*)bench_dst, FS_CHUNK_SIZE - 1);
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("lz_compress", FS_CHUNK_SIZE);
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        bench_sink = lz_decompress((const uint8_t*)bench_dst, packed,
+                                   (uint8_t*)bench_src + FS_CHUNK_SIZE, FS_CHUNK_SIZE);
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("lz_decompress", FS_CHUNK_SIZE);
+}
+
+void bench_cli() {
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        update_cli_display();
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("update_cli_display", 0);
+
+    /* 키 입력 처리: ISR이 포트에서 읽은 스캔코드를 넘긴 뒤 화면 갱신까지.
+       실행 중인 명령줄을 보존하기 위해 매번 삽입한 글자를 되돌린다. */
+    if (cli_length >= CLI_BUFFER_SIZE - 1) return;
+    int saved_cursor = cli_cursor;
+    cli_cursor = cli_length;
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        process_keyboard(0x1E);    /* 'a' make code */
+        bench_samples[i] = rdtsc32() - t0;
+        cli_length--;
+        cli_cursor--;
+        cli_buffer[cli_length] = '\0';
+    }
+    cli_cursor = saved_cursor;
+    bench_report("kbd_dispatch", 0);
+}
+
+void bench_elf_load() {
+    Elf32_Ehdr* header = (Elf32_Ehdr*)bench_elf;
+    Elf32_Phdr* phdr = (Elf32_Phdr*)(bench_elf + sizeof(Elf32_Ehdr));
+    for (size_t i = 0; i < sizeof(bench_elf); i++) bench_elf[i] = 0;
+    header->e_ident[0] = 0x7F;
+    header->e_ident[1] = 'E';
+    header->e_ident[2] = 'L';
+    header->e_ident[3] = 'F';
+    header->e_entry = BENCH_ELF_VADDR;
+    header->e_phoff = sizeof(Elf32_Ehdr);
+    header->e_phentsize = sizeof(Elf32_Phdr);
+    header->e_phnum = 2;
+    /* 읽기 전용 코드 세그먼트와, 재실행 때마다 되돌려야 하는 쓰기 가능 데이터+.bss */
+    phdr[0].p_type = PT_LOAD;
+    phdr[0].p_offset = sizeof(Elf32_Ehdr) + 2 * sizeof(Elf32_Phdr);
+    phdr[0].p_vaddr = BENCH_ELF_VADDR;
+    phdr[0].p_filesz = BENCH_ELF_FILESZ / 2;
+    phdr[0].p_memsz = BENCH_ELF_FILESZ / 2;
+    phdr[0].p_flags = PF_R | PF_X;
+    phdr[1].p_type = PT_LOAD;
+    phdr[1].p_offset = phdr[0].p_offset + BENCH_ELF_FILESZ / 2;
+    phdr[1].p_vaddr = BENCH_ELF_VADDR + 0x1000;
+    phdr[1].p_filesz = BENCH_ELF_FILESZ / 2;
+    phdr[1].p_memsz = BENCH_ELF_MEMSZ - BENCH_ELF_FILESZ / 2;
+    phdr[1].p_flags = PF_R | PF_W;
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        elf_load(bench_elf, sizeof(bench_elf));
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("elf_load", BENCH_ELF_MEMSZ);
+
+    /* 기억FS 파일로 실행: 매번 다시 써서 캐시를 무효화한 경우와 캐시 적중 재실행 */
+    char name[MAX_FILENAME_LEN];
+    char full_path[MAX_FILENAME_LEN];
+    bench_name(name, 0);
+    build_full_path(name, full_path, MAX_FILENAME_LEN);
+    int idx = fs_create_file(name);
+    if (idx < 0) {
+        kprintln("elf_cold: 빈 슬롯이 없어 건너뜁니다.");
+        return;
+    }
+    uint32_t saved_hits = elf_cache_hits, saved_misses = elf_cache_misses;
+    uint32_t saved_cold = elf_cold_cycles, saved_relaunch = elf_relaunch_cycles;
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        fs_write(idx, bench_elf, sizeof(bench_elf));
+        uint32_t t0 = rdtsc32();
+        elf_file_load(idx);
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("elf_cold", BENCH_ELF_MEMSZ);
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        elf_file_load(idx);
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("elf_relaunch", BENCH_ELF_MEMSZ);
+    elf_cache_hits = saved_hits;
+    elf_cache_misses = saved_misses;
+    elf_cold_cycles = saved_cold;
+    elf_relaunch_cycles = saved_relaunch;
+    fs_delete(full_path);
+}
+
+/* 벤치마크는 현재 디렉토리와 상관없이 "/"에서 돌리고, 벤치마크가 만든
+   fs_find/청크 캐시 조회는 /proc/fs 통계에 남기지 않는다 */
+void run_benchmarks() {
+    char saved_dir[sizeof(current_directory)];
+    CpuStats* stats = this_cpu();
+    uint32_t saved_find_hits = stats->fs_find_hits, saved_find_misses = stats->fs_find_misses;
+    uint32_t saved_cache_hits = stats->fs_cache_hits, saved_cache_misses = stats->fs_cache_misses;
+    kstrncpy(saved_dir, current_directory, sizeof(saved_dir));
+    kstrncpy(current_directory, "/", sizeof(current_directory));
+    kprintln("=== Benchmarks (cycles) ===");
+    serial_print("bench,name,param,iters,min,median,p99\n");
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        uint32_t t0 = rdtsc32();
+        bench_samples[i] = rdtsc32() - t0;
+    }
+    bench_report("tsc_overhead", 0);
+    bench_fs();
+    bench_strings();
+    bench_cli();
+    bench_elf_load();
+    serial_print("bench,end\n");
+    kstrncpy(current_directory, saved_dir, sizeof(current_directory));
+    stats->fs_find_hits = saved_find_hits;
+    stats->fs_find_misses = saved_find_misses;
+    stats->fs_cache_hits = saved_cache_hits;
+    stats->fs_cache_misses = saved_cache_misses;
+}
+
+/* ======================= /proc 생성 함수 ======================= */
+/* 내장 명령어: 번호는 명령어별 실행 횟수의 색인, 이름은 디스패치와 /proc/commands가
+   함께 쓴다. 마지막 칸(BUILTIN_UNKNOWN)은 알 수 없는 명령어 */
+enum {
+    CMD_CD, CMD_CD_UP, CMD_MD, CMD_RM, CMD_PWD, CMD_LS, CMD_DIR, CMD_CAT, CMD_ECHO,
+    CMD_CLEAR, CMD_HELP, CMD_HISTORY, CMD_SHRED, CMD_LINKFILE, CMD_TOUCH, CMD_CP,
+    CMD_MV, CMD_FIND, CMD_GREP, CMD_EXECBIN, CMD_EXECELF, CMD_COMPRESS,
+    CMD_ELFCACHE, CMD_MEMINFO, CMD_BENCH, CMD_SHUTDOWN, CMD_COUNT
+};
+const char* builtin_names[CMD_COUNT] = {
+    "cd", "cd..", "md", "rm", "pwd", "ls", "dir", "cat", "echo", "clear",
+    "help", "history", "shred", "linkfile", "touch", "cp", "mv", "find", "grep",
+    "execbin", "execelf", "compress", "elfcache", "meminfo", "bench", "shutdown"
+};
+#define BUILTIN_UNKNOWN (MAX_BUILTINS - 1)
+
+typedef char builtin_table_fits[CMD_COUNT < MAX_BUILTINS ? 1 : -1];
+
+/* 디스패치 비교: 일치하면 그 명령어의 실행 횟수를 올린다 */
+int command_is(const char* name, int cmd) {
+    if (kstrcmp(name, builtin_names[cmd]) != 0) return 0;
+    this_cpu()->command_count[cmd]++;
+    return 1;
+}
+
+/* ISR 한 번의 처리 시간을 해당 IRQ의 로그 스케일 히스토그램에 기록 */
+void irq_account(int irq, uint32_t cycles) {
+    int bucket = (31 - __builtin_clz(cycles | 1)) - 6;
+    if (bucket < 0) bucket = 0;
+    if (bucket >= IRQ_HIST_BUCKETS) bucket = IRQ_HIST_BUCKETS - 1;
+    CpuStats* stats = this_cpu();
+    stats->irq_count[irq]++;
+    stats->irq_latency[irq][bucket]++;
+}
+
+/* /proc/irq: IRQ별 횟수와 처리 시간 분포 (0이 아닌 버킷만) */
+void proc_gen_irq(ProcWriter* w) {
+    for (int irq = 0; irq < IRQ_LINES; irq++) {
+        uint32_t count = 0;
+        for (int c = 0; c < MAX_CPUS; c++) count += cpu_stats[c].irq_count[irq];
+        if (count == 0) continue;
+        proc_puts(w, "irq ");
+        proc_putu(w, irq);
+        proc_puts(w, ": ");
+        proc_putu(w, count);
+        proc_puts(w, "\n");
+        for (int b = 0; b < IRQ_HIST_BUCKETS; b++) {
+            uint32_t n = 0;
+            for (int c = 0; c < MAX_CPUS; c++) n += cpu_stats[c].irq_latency[irq][b];
+            if (n == 0) continue;
+            proc_puts(w, b == IRQ_HIST_BUCKETS - 1 ? "  >= " : "  < ");
+            proc_putu(w, 1u << (b + (b == IRQ_HIST_BUCKETS - 1 ? 6 : 7)));
+            proc_puts(w, " cycles: ");
+            proc_putu(w, n);
+            proc_puts(w, "\n");
+        }
+    }
+}
+
+/* /proc/fs: 슬롯, 데이터 풀, 청크 캐시, fs_find 적중률 */
+void proc_gen_fs(ProcWriter* w) {
+    uint32_t hits = 0, misses = 0, cache_hits = 0, cache_misses = 0;
+    for (int c = 0; c < MAX_CPUS; c++) {
+        hits += cpu_stats[c].fs_find_hits;
+        misses += cpu_stats[c].fs_find_misses;
+        cache_hits += cpu_stats[c].fs_cache_hits;
+        cache_misses += cpu_stats[c].fs_cache_misses;
+    }
+    size_t logical = 0, stored = 0;
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (!fs.files[i].used || fs.files[i].is_directory) continue;
+        logical += fs.files[i].size;
+        stored += fs_stored_size(i);
+    }
+    proc_puts(w, "slots_used ");
+    proc_putu(w, fs.file_count);
+    proc_puts(w, "\nslots_total ");
+    proc_putu(w, MAX_FILES);
+    proc_puts(w, "\npool_used ");
+    proc_putu(w, fs.blocks_used * FS_BLOCK_SIZE);
+    proc_puts(w, "\npool_total ");
+    proc_putu(w, FS_DATA_BLOCKS * FS_BLOCK_SIZE);
+    proc_puts(w, "\nreserved_bytes ");
+    proc_putu(w, FS_RESERVED_BYTES);
+    proc_puts(w, "\nflat_bytes ");
+    proc_putu(w, FS_FLAT_BYTES);
+    proc_puts(w, "\ncontent_bytes ");
+    proc_putu(w, logical);
+    proc_puts(w, "\nstored_bytes ");
+    proc_putu(w, stored);
+    proc_puts(w, "\nchunk_cache_hits ");
+    proc_putu(w, cache_hits);
+    proc_puts(w, "\nchunk_cache_misses ");
+    proc_putu(w, cache_misses);
+    proc_puts(w, "\nfs_find_hits ");
+    proc_putu(w, hits);
+    proc_puts(w, "\nfs_find_misses ");
+    proc_putu(w, misses);
+    proc_puts(w, "\n");
+}
+
+/* /proc/commands: 내장 명령어별 실행 횟수 (0이 아닌 것만) */
+void proc_gen_commands(ProcWriter* w) {
+    for (int i = 0; i < MAX_BUILTINS; i++) {
+        uint32_t n = 0;
+        for (int c = 0; c < MAX_CPUS; c++) n += cpu_stats[c].command_count[i];
+        if (n == 0) continue;
+        proc_puts(w, i == BUILTIN_UNKNOWN ? "(unknown)" : builtin_names[i]);
+        proc_puts(w, " ");
+        proc_putu(w, n);
+        proc_puts(w, "\n");
+    }
+}
+
+/* 타이머/스케줄러가 없으므로 해당 파일은 없다 */
+const ProcFile kernel_proc_files[] = {
+    { "irq",      proc_gen_irq },
+    { "fs",       proc_gen_fs },
+    { "commands", proc_gen_commands },
+};
+
+void init_procfs() {
+    proc_files = kernel_proc_files;
+    proc_file_count = sizeof(kernel_proc_files) / sizeof(kernel_proc_files[0]);
+}
+
 /* ======================= CLI 명령어 처리 ======================= */
 void process_command() {
     /* 히스토리에 저장 (빈 명령어는 저장하지 않음) */
@@ -544,53 +2007,64 @@ void process_command() {
     
     char* tokens[10];
     int token_count = tokenize(cli_buffer, tokens, 10);
-    if (token_count == 0) return;
     
-    if (kstrcmp(tokens[0], "cd") == 0) {
+    if (token_count == 0) {
+         /* 빈 줄: 아래 공통 부분에서 입력 상태만 비우고 프롬프트를 다시 낸다 */
+    } else if (command_is(tokens[0], CMD_CD)) {
          if (token_count < 2)
              kprintln("사용법: cd <directory>");
          else
              fs_change_directory(tokens[1]);
-    } else if (kstrcmp(tokens[0], "cd..") == 0) {
+    } else if (command_is(tokens[0], CMD_CD_UP)) {
          fs_change_directory("..");
-    } else if (kstrcmp(tokens[0], "md") == 0) {
+    } else if (command_is(tokens[0], CMD_MD)) {
          if (token_count < 2)
              kprintln("사용법: md <directory>");
          else
              fs_create_directory(tokens[1]);
-    } else if (kstrcmp(tokens[0], "rm") == 0) {
+    } else if (command_is(tokens[0], CMD_RM)) {
          if (token_count < 2)
              kprintln("사용법: rm <file_or_directory>");
-         else
-             fs_delete(tokens[1]);
-    } else if (kstrcmp(tokens[0], "pwd") == 0) {
+         else {
+             char full_path[MAX_FILENAME_LEN];
+             build_full_path(tokens[1], full_path, MAX_FILENAME_LEN);
+             fs_delete(full_path);
+         }
+    } else if (command_is(tokens[0], CMD_PWD)) {
          kprintln(current_directory);
-    } else if (kstrcmp(tokens[0], "ls") == 0 || kstrcmp(tokens[0], "dir") == 0) {
+    } else if (command_is(tokens[0], CMD_LS) || command_is(tokens[0], CMD_DIR)) {
          fs_list_directory();
-    } else if (kstrcmp(tokens[0], "cat") == 0) {
+    } else if (command_is(tokens[0], CMD_CAT)) {
          if (token_count < 2)
              kprintln("사용법: cat <file>");
          else {
              char full_path[MAX_FILENAME_LEN];
              build_full_path(tokens[1], full_path, MAX_FILENAME_LEN);
-             int idx = fs_find(full_path);
-             if (idx == -1 || fs.files[idx].is_directory)
+             int proc = proc_lookup(full_path);
+             int idx = proc >= 0 ? -1 : fs_find(full_path);
+             if (proc >= 0) {
+                 size_t n = proc_read(proc, file_buffer, MAX_FILE_SIZE);
+                 file_buffer[n] = '\0';
+                 kprint(file_buffer);
+             } else if (idx == -1 || fs.files[idx].is_directory)
                  kprintln("파일이 존재하지 않거나 디렉토리입니다.");
              else {
+                 size_t n = fs_read(idx, 0, file_buffer, fs.files[idx].size);
+                 file_buffer[n] = '\0';
                  kprintln("File content:");
-                 kprintln(fs.files[idx].content);
+                 kprintln(file_buffer);
              }
          }
-    } else if (kstrcmp(tokens[0], "echo") == 0) {
+    } else if (command_is(tokens[0], CMD_ECHO)) {
          for (int i = 1; i < token_count; i++) {
              kprint(tokens[i]);
              if (i < token_count - 1)
                  kprint(" ");
          }
          kprintln("");
-    } else if (kstrcmp(tokens[0], "clear") == 0) {
+    } else if (command_is(tokens[0], CMD_CLEAR)) {
          clear_screen();
-    } else if (kstrcmp(tokens[0], "help") == 0) {
+    } else if (command_is(tokens[0], CMD_HELP)) {
          kprintln("Available commands:");
          kprintln("cd <dir>       - change directory");
          kprintln("cd..           - go to parent directory");
@@ -598,7 +2072,7 @@ void process_command() {
          kprintln("rm <file/dir>  - remove file/directory");
          kprintln("pwd            - print working directory");
          kprintln("ls or dir      - list directory contents");
-         kprintln("cat <file>     - display file content");
+         kprintln("cat <file>     - display file content (/proc: kernel stats)");
          kprintln("echo <text>    - print text");
          kprintln("clear          - clear the screen");
          kprintln("history        - show command history");
@@ -608,52 +2082,58 @@ void process_command() {
          kprintln("cp <src> <dest> - copy file");
          kprintln("mv <src> <dest> - move/rename file");
          kprintln("find <pattern> - search files");
+         kprintln("grep <pattern> - search file contents");
          kprintln("execbin <file> - execute raw binary file");
          kprintln("execelf <file> - execute ELF file");
-    } else if (kstrcmp(tokens[0], "history") == 0) {
+         kprintln("elfcache       - show ELF image cache stats");
+         kprintln("compress <file> <on|off> - toggle file compression");
+         kprintln("meminfo        - show memory and compression stats");
+         kprintln("bench          - run kernel microbenchmarks");
+         kprintln("shutdown       - exit QEMU (isa-debug-exit)");
+    } else if (command_is(tokens[0], CMD_HISTORY)) {
          kprintln("Command History:");
          for (int i = 0; i < history_count; i++)
              kprintln(command_history[i]);
-    } else if (kstrcmp(tokens[0], "shred") == 0) {
+    } else if (command_is(tokens[0], CMD_SHRED)) {
          if (token_count < 2)
              kprintln("사용법: shred <file>");
          else
              fs_shred_file(tokens[1]);
-    } else if (kstrcmp(tokens[0], "linkfile") == 0) {
+    } else if (command_is(tokens[0], CMD_LINKFILE)) {
          if (token_count < 3)
              kprintln("사용법: linkfile <source> <linkname>");
          else
              fs_link_file(tokens[1], tokens[2]);
-    } else if (kstrcmp(tokens[0], "touch") == 0) {
+    } else if (command_is(tokens[0], CMD_TOUCH)) {
          if (token_count < 2)
              kprintln("사용법: touch <file>");
          else
              fs_touch(tokens[1]);
-    } else if (kstrcmp(tokens[0], "cp") == 0) {
+    } else if (command_is(tokens[0], CMD_CP)) {
          if (token_count < 3)
              kprintln("사용법: cp <source> <destination>");
          else
              fs_copy_file(tokens[1], tokens[2]);
-    } else if (kstrcmp(tokens[0], "mv") == 0) {
+    } else if (command_is(tokens[0], CMD_MV)) {
          if (token_count < 3)
              kprintln("사용법: mv <source> <destination>");
          else
              fs_move_file(tokens[1], tokens[2]);
-    } else if (kstrcmp(tokens[0], "find") == 0) {
+    } else if (command_is(tokens[0], CMD_FIND)) {
          if (token_count < 2)
              kprintln("사용법: find <pattern>");
          else {
-             int found = 0;
-             for (int i = 0; i < MAX_FILES; i++) {
-                 if (fs.files[i].used && kstrcontains(fs.files[i].name, tokens[1])) {
-                     kprintln(fs.files[i].name);
-                     found = 1;
-                 }
-             }
-             if (!found)
+             if (!fs_find_pattern(tokens[1]))
                  kprintln("No matching files found.");
          }
-    } else if (kstrcmp(tokens[0], "execbin") == 0) {
+    } else if (command_is(tokens[0], CMD_GREP)) {
+         if (token_count < 2)
+             kprintln("사용법: grep <pattern>");
+         else {
+             if (!fs_grep(tokens[1]))
+                 kprintln("No matching lines found.");
+         }
+    } else if (command_is(tokens[0], CMD_EXECBIN)) {
          if (token_count < 2)
              kprintln("사용법: execbin <file>");
          else {
@@ -664,10 +2144,11 @@ void process_command() {
                  kprintln("File not found or is a directory.");
              else {
                  kprintln("Loading raw binary...");
-                 exec_bin(fs.files[idx].content, fs.files[idx].size);
+                 size_t n = fs_read(idx, 0, file_buffer, fs.files[idx].size);
+                 exec_bin(file_buffer, n);
              }
          }
-    } else if (kstrcmp(tokens[0], "execelf") == 0) {
+    } else if (command_is(tokens[0], CMD_EXECELF)) {
          if (token_count < 2)
              kprintln("사용법: execelf <file>");
          else {
@@ -678,16 +2159,62 @@ void process_command() {
                  kprintln("File not found or is a directory.");
              else {
                  kprintln("Loading ELF file...");
-                 exec_elf(fs.files[idx].content, fs.files[idx].size);
+                 exec_elf_file(idx);
              }
          }
+    } else if (command_is(tokens[0], CMD_COMPRESS)) {
+         if (token_count < 3 ||
+             (kstrcmp(tokens[2], "on") != 0 && kstrcmp(tokens[2], "off") != 0))
+             kprintln("사용법: compress <file> <on|off>");
+         else {
+             char full_path[MAX_FILENAME_LEN];
+             build_full_path(tokens[1], full_path, MAX_FILENAME_LEN);
+             int idx = fs_find(full_path);
+             if (idx == -1 || fs.files[idx].is_directory)
+                 kprintln("파일이 존재하지 않거나 디렉토리입니다.");
+             else
+                 fs_set_compression(idx, kstrcmp(tokens[2], "on") == 0);
+         }
+    } else if (command_is(tokens[0], CMD_ELFCACHE)) {
+         elf_cache_print_stats();
+    } else if (command_is(tokens[0], CMD_MEMINFO)) {
+         fs_print_meminfo();
+    } else if (command_is(tokens[0], CMD_BENCH)) {
+         run_benchmarks();
+    } else if (command_is(tokens[0], CMD_SHUTDOWN)) {
+         qemu_exit(0);
+         kprintln("shutdown: isa-debug-exit 장치가 없습니다.");
     } else {
+         this_cpu()->command_count[BUILTIN_UNKNOWN]++;
          kprintln("알 수 없는 명령어");
     }
     cli_length = 0;
     cli_cursor = 0;
     cli_buffer[0] = '\0';
     update_cli_display();
+    serial_print(">> ");
+}
+
+/* ======================= 키 입력 처리 (키보드/시리얼 공통) ======================= */
+void process_key(char key) {
+    if (key == '\n') {
+        process_command();
+    } else if (key == '\b') {
+        if (cli_cursor > 0 && cli_length > 0) {
+            for (int i = cli_cursor - 1; i < cli_length - 1; i++)
+                cli_buffer[i] = cli_buffer[i+1];
+            cli_length--; cli_cursor--;
+            cli_buffer[cli_length] = '\0';
+        }
+    } else if (key != 0) {
+        if (cli_length < CLI_BUFFER_SIZE - 1) {
+            for (int i = cli_length; i > cli_cursor; i--)
+                cli_buffer[i] = cli_buffer[i-1];
+            cli_buffer[cli_cursor] = key;
+            cli_length++; cli_cursor++;
+        }
+    }
+    update_cli_display();
 }
 
 /* ======================= 키보드 드라이버 ======================= */
@@ -710,25 +2237,36 @@ void process_keyboard(uint8_t scancode) {
         return;
     }
     if (scancode & 0x80) return;
-    char key = scancode_map[scancode];
-    if (key == '\n') {
-        process_command();
-    } else if (key == '\b') {
-        if (cli_cursor > 0 && cli_length > 0) {
-            for (int i = cli_cursor - 1; i < cli_length - 1; i++)
-                cli_buffer[i] = cli_buffer[i+1];
-            cli_length--; cli_cursor--;
-            cli_buffer[cli_length] = '\0';
-        }
-    } else if (key != 0) {
-        if (cli_length < CLI_BUFFER_SIZE - 1) {
-            for (int i = cli_length; i > cli_cursor; i--)
-                cli_buffer[i] = cli_buffer[i-1];
-            cli_buffer[cli_cursor] = key;
-            cli_length++; cli_cursor++;
-        }
-    }
-    update_cli_display();
+    process_key(scancode_map[scancode]);
+}
+
+/* ======================= GDT (평면 메모리 모델) ======================= */
+/* 부트로더가 남긴 GDT에 의존하지 않도록 코드 0x08, 데이터 0x10을 직접 설정 */
+struct gdt_ptr {
+    uint16_t limit;
+    uint32_t base;
+} __attribute__((packed));
+
+uint32_t gdt[6] = {
+    0x00000000, 0x00000000,    /* null */
+    0x0000FFFF, 0x00CF9A00,    /* 0x08: 코드, base 0, limit 4GB */
+    0x0000FFFF, 0x00CF9200     /* 0x10: 데이터, base 0, limit 4GB */
+};
+struct gdt_ptr gdtp;
+
+void init_gdt() {
+    gdtp.limit = sizeof(gdt) - 1;
+    gdtp.base = (uint32_t)&gdt;
+    asm volatile ("lgdt (%0)\n"
+                  "ljmp $0x08, $1f\n"
+                  "1:\n"
+                  "mov $0x10, %%ax\n"
+                  "mov %%ax, %%ds\n"
+                  "mov %%ax, %%es\n"
+                  "mov %%ax, %%fs\n"
+                  "mov %%ax, %%gs\n"
+                  "mov %%ax, %%ss\n"
+                  : : "r" (&gdtp) : "eax", "memory");
 }
 
 /* ======================= PIC, IDT 및 인터럽트 초기화 ======================= */
@@ -761,7 +2299,9 @@ void init_idt() {
     idtp.base = (uint32_t)&idt;
     for (int i = 0; i < 256; i++) set_idt_gate(i, 0);
     extern void keyboard_interrupt_handler();
+    extern void serial_interrupt_handler();
     set_idt_gate(0x21, (uint32_t)keyboard_interrupt_handler);
+    set_idt_gate(0x24, (uint32_t)serial_interrupt_handler);
     asm volatile ("lidt (%0)" : : "r" (&idtp));
 }
 
@@ -774,24 +2314,126 @@ void init_pic() {
     outb(0xA1, 0x02);
     outb(0x21, 0x01);
     outb(0xA1, 0x01);
-    outb(0x21, 0x0);
-    outb(0xA1, 0x0);
+    /* 핸들러가 있는 IRQ1(키보드), IRQ4(COM1)만 허용 */
+    outb(0x21, 0xFF & ~((1 << 1) | (1 << 4)));
+    outb(0xA1, 0xFF);
 }
 
 __attribute__((interrupt))
 void keyboard_interrupt_handler(void* frame) {
+    uint32_t t0 = rdtsc32();
     uint8_t scancode = inb(0x60);
     process_keyboard(scancode);
+    irq_account(1, rdtsc32() - t0);
     outb(0x20, 0x20);
 }
 
+/* COM1 수신: 터미널의 CR/DEL을 CLI의 개행/백스페이스로 바꾸고 에코한다 */
+__attribute__((interrupt))
+void serial_interrupt_handler(void* frame) {
+    uint32_t t0 = rdtsc32();
+    while (inb(COM1_PORT + 5) & 0x01) {
+        char c = (char)inb(COM1_PORT);
+        if (c == '\r') c = '\n';
+        else if (c == 0x7F) c = '\b';
+        if (c == '\n') serial_print("\n");
+        else if (c == '\b') serial_print("\b \b");
+        else if (c >= ' ') serial_putc(c);
+        else continue;
+        process_key(c);
+    }
+    irq_account(4, rdtsc32() - t0);
+    outb(0x20, 0x20);
+}
+
+/* ======================= 멀티부트 진입점 ======================= */
+/* GRUB이나 "qemu -kernel"로 바로 부팅할 수 있도록 멀티부트 v1 헤더를 둔다.
+   링커 스크립트가 .multiboot 섹션을 이미지 맨 앞에 배치한다. */
+#define MULTIBOOT_HEADER_MAGIC     0x1BADB002
+#define MULTIBOOT_HEADER_FLAGS     0x00000003    /* 모듈 페이지 정렬 + 메모리 정보 */
+#define MULTIBOOT_BOOTLOADER_MAGIC 0x2BADB002
+#define MULTIBOOT_INFO_MODS        0x00000008
+#define KERNEL_STACK_SIZE          16384
+
+__attribute__((section(".multiboot"), aligned(4), used))
+const uint32_t multiboot_header[3] = {
+    MULTIBOOT_HEADER_MAGIC,
+    MULTIBOOT_HEADER_FLAGS,
+    -(MULTIBOOT_HEADER_MAGIC + MULTIBOOT_HEADER_FLAGS)
+};
+
+uint8_t kernel_stack[KERNEL_STACK_SIZE] __attribute__((aligned(16)));
+
+/* 부트로더가 넘긴 EAX(매직), EBX(정보 구조체)를 kernel_main 인자로 전달 */
+asm (".text\n"
+     ".global _start\n"
+     "_start:\n"
+     "    mov $(kernel_stack + 16384), %esp\n"
+     "    push %ebx\n"
+     "    push %eax\n"
+     "    call kernel_main\n"
+     "1:  hlt\n"
+     "    jmp 1b\n");
+
+typedef struct {
+    uint32_t flags;
+    uint32_t mem_lower;
+    uint32_t mem_upper;
+    uint32_t boot_device;
+    uint32_t cmdline;
+    uint32_t mods_count;
+    uint32_t mods_addr;
+} MultibootInfo;
+
+typedef struct {
+    uint32_t mod_start;
+    uint32_t mod_end;
+    uint32_t string;
+    uint32_t reserved;
+} MultibootModule;
+
+/* 부트 모듈(예: qemu -initrd)을 기억FS 루트에 파일로 복사. 이름은 경로의 마지막 부분 */
+void import_boot_modules(uint32_t magic, MultibootInfo* info) {
+    if (magic != MULTIBOOT_BOOTLOADER_MAGIC || !(info->flags & MULTIBOOT_INFO_MODS))
+        return;
+    MultibootModule* mods = (MultibootModule*)info->mods_addr;
+    for (uint32_t m = 0; m < info->mods_count; m++) {
+        const char* name = mods[m].string ? (const char*)mods[m].string : "module";
+        for (const char* p = name; *p && *p != ' '; p++)
+            if (*p == '/') name = p + 1;
+        char base[MAX_FILENAME_LEN];
+        int len = 0;
+        while (name[len] && name[len] != ' ' && len < MAX_FILENAME_LEN - 2) {
+            base[len] = name[len];
+            len++;
+        }
+        base[len] = '\0';
+        size_t size = mods[m].mod_end - mods[m].mod_start;
+        if (size > MAX_FILE_SIZE) {
+            kprint(base);
+            kprintln(": 파일 크기 제한을 넘어 잘립니다.");
+            size = MAX_FILE_SIZE;
+        }
+        int idx = fs_create_file(base);
+        if (idx < 0) continue;
+        fs_write(idx, (const char*)mods[m].mod_start, size);
+    }
+}
+
 /* ======================= 미래 OS 커널 메인 ======================= */
-void kernel_main(void) {
+void kernel_main(uint32_t magic, MultibootInfo* info) {
+    init_gdt();
+    init_serial();       // COM1 (시리얼 콘솔, 벤치마크 결과 출력)
     kprintln("미래 Kernel started!");
     init_fs();           // 기억FS 초기화 (루트 디렉토리 생성)
+    init_procfs();       // 모듈 이름이 /proc을 가리지 않도록 가져오기 전에 등록
+    init_elf_cache();
+    import_boot_modules(magic, info);
     init_pic();
     init_idt();
     asm volatile ("sti"); // 인터럽트 활성화
     update_cli_display(); // CLI 초기 화면 출력
+    serial_print(">> ");
     while (1) { asm volatile ("hlt"); }
 }
+#endif /* KERNEL_HOSTED */
@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""qemu_harness.py - 미래 OS 헤드리스 벤치마크/회귀 하네스
+
+커널을 QEMU에서 화면 없이 부팅하고 시리얼 콘솔(COM1)로 셸을 조작한다.
+정해진 워크로드(파일 N개 생성, cp/find/ls, execelf 두 번, bench, rm 정리)를 실행한 뒤
+shutdown 명령으로 isa-debug-exit를 통해 종료하고, 측정값을 결과 파일에
+"<metric> <value>" 형식으로 기록한다.
+
+--baseline이 주어지면 추적 대상 지표(bench.*.median)가 기준값보다
+threshold 비율 이상 나빠졌을 때 실패(종료 코드 1)한다. 기준 파일이
+아직 없으면 결과만 기록하고 검사는 건너뛴다.
+"""
+
+import argparse
+import os
+import struct
+import subprocess
+import sys
+import threading
+import time
+
+PROMPT = ">> "
+ELF_VADDR = 0x400000
+
+
+def make_test_elf(path):
+    """PT_LOAD 세그먼트 하나에 `ret`만 있는 최소 ELF32 실행 파일 생성."""
+    code = b"\xc3"
+    ehsize, phsize = 52, 32
+    offset = ehsize + phsize
+    ident = b"\x7fELF" + bytes([1, 1, 1]) + bytes(9)
+    header = ident + struct.pack("<HHIIIIIHHHHHH",
+                                 2, 3, 1, ELF_VADDR, ehsize, 0, 0,
+                                 ehsize, phsize, 1, 0, 0, 0)
+    phdr = struct.pack("<IIIIIIII",
+                       1, offset, ELF_VADDR, ELF_VADDR,
+                       len(code), len(code), 5, 4)
+    with open(path, "wb") as f:
+        f.write(header + phdr + code)
+
+
+class SerialShell:
+    """QEMU 시리얼 stdio로 셸 명령을 보내고 다음 프롬프트까지의 출력을 받는다."""
+
+    def __init__(self, argv, timeout):
+        self.timeout = timeout
+        self.proc = subprocess.Popen(argv, stdin=subprocess.PIPE,
+                                     stdout=subprocess.PIPE,
+                                     stderr=subprocess.STDOUT)
+        self.buf = b""
+        self.cond = threading.Condition()
+        self.eof = False
+        self.reader = threading.Thread(target=self._read, daemon=True)
+        self.reader.start()
+
+    def _read(self):
+        while True:
+            chunk = self.proc.stdout.read1(4096)
+            with self.cond:
+                if not chunk:
+                    self.eof = True
+                    self.cond.notify_all()
+                    return
+                self.buf += chunk
+                self.cond.notify_all()
+
+    def wait_prompt(self):
+        deadline = time.monotonic() + self.timeout
+        with self.cond:
+            while PROMPT.encode() not in self.buf:
+                left = deadline - time.monotonic()
+                if self.eof or left <= 0:
+                    raise RuntimeError("프롬프트 대기 실패:\n"
+                                       + self.buf.decode("utf-8", "replace"))
+                self.cond.wait(left)
+            out, _, self.buf = self.buf.partition(PROMPT.encode())
+        return out.decode("utf-8", "replace").replace("\r", "")
+
+    def run(self, command):
+        """명령 실행 후 (출력, 경과 시간[초]) 반환."""
+        start = time.perf_counter()
+        self.proc.stdin.write(command.encode() + b"\r")
+        self.proc.stdin.flush()
+        out = self.wait_prompt()
+        return out, time.perf_counter() - start
+
+    def shutdown(self):
+        self.proc.stdin.write(b"shutdown\r")
+        self.proc.stdin.flush()
+        try:
+            return self.proc.wait(self.timeout)
+        except subprocess.TimeoutExpired:
+            self.proc.kill()
+            raise RuntimeError("shutdown 후 QEMU가 종료되지 않았습니다")
+
+
+def parse_bench(output, metrics):
+    """bench 명령의 "bench,<name>,<param>,<iters>,<min>,<median>,<p99>" 줄 수집."""
+    for line in output.splitlines():
+        fields = line.strip().split(",")
+        if len(fields) != 7 or fields[0] != "bench" or fields[1] == "name":
+            continue
+        name, param = fields[1], fields[2]
+        for key, value in zip(("min", "median", "p99"), fields[4:]):
+            metrics["bench.%s.%s.%s" % (name, param, key)] = int(value)
+
+
+def run_workload(args):
+    os.makedirs(os.path.dirname(os.path.abspath(args.results)), exist_ok=True)
+    elf_path = os.path.join(os.path.dirname(os.path.abspath(args.results)),
+                            "hello.elf")
+    make_test_elf(elf_path)
+
+    argv = [args.qemu, "-kernel", args.kernel, "-initrd", elf_path,
+            "-display", "none", "-serial", "stdio", "-monitor", "none",
+            "-no-reboot",
+            "-device", "isa-debug-exit,iobase=0xf4,iosize=0x04"]
+    metrics = {}
+    start = time.perf_counter()
+    shell = SerialShell(argv, args.timeout)
+    try:
+        shell.wait_prompt()
+        metrics["wall.boot_us"] = int((time.perf_counter() - start) * 1e6)
+
+        def step(metric, command):
+            out, elapsed = shell.run(command)
+            key = "wall.%s_us" % metric
+            metrics[key] = metrics.get(key, 0) + int(elapsed * 1e6)
+            return out
+
+        for i in range(args.files):
+            step("touch", "touch f%d" % i)
+        step("cp", "cp f0 c0")
+        # 입력 에코("find f0")가 아니라 커널이 출력한 경로 줄을 확인한다
+        if "/f0" not in step("find", "find f0").splitlines():
+            raise RuntimeError("find가 f0를 찾지 못했습니다")
+        step("ls", "ls")
+        if "Jumping to ELF entry point" not in step("execelf", "execelf hello.elf"):
+            raise RuntimeError("execelf 실패")
+        # 두 번째 실행은 실행 이미지 캐시에서 재실행된다
+        step("execelf_relaunch", "execelf hello.elf")
+        if "1 hits" not in step("elfcache", "elfcache"):
+            raise RuntimeError("실행 이미지 캐시가 적중하지 않았습니다")
+        parse_bench(step("bench", "bench"), metrics)
+        if "slots_used" not in step("proc", "cat /proc/fs"):
+            raise RuntimeError("/proc/fs를 읽지 못했습니다")
+        for name in ["f%d" % i for i in range(args.files)] + ["c0"]:
+            if "존재하지 않습니다" in step("rm", "rm /%s" % name):
+                raise RuntimeError("rm이 /%s를 지우지 못했습니다" % name)
+        if "No matching files found." not in step("find_gone", "find f0"):
+            raise RuntimeError("rm 뒤에도 f0가 남아 있습니다")
+        # 빈 줄에도 프롬프트가 다시 나와야 한다
+        step("empty", "")
+    except Exception:
+        shell.proc.kill()
+        raise
+    status = shell.shutdown()
+    # isa-debug-exit: 커널이 0을 쓰면 QEMU 종료 코드는 1
+    if status != 1:
+        raise RuntimeError("예상하지 못한 QEMU 종료 코드: %d" % status)
+
+    with open(args.results, "w") as f:
+        for key in sorted(metrics):
+            f.write("%s %d\n" % (key, metrics[key]))
+    return metrics
+
+
+def load_results(path):
+    metrics = {}
+    with open(path) as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) == 2 and not line.startswith("#"):
+                metrics[parts[0]] = int(parts[1])
+    return metrics
+
+
+def is_tracked(metric):
+    return metric.startswith("bench.") and metric.endswith(".median")
+
+
+def compare(current, baseline, threshold):
+    """회귀한 지표 목록 [(metric, 기준값, 현재값)] 반환."""
+    regressions = []
+    for key in sorted(baseline):
+        if not is_tracked(key) or key not in current:
+            continue
+        limit = baseline[key] * (1.0 + threshold)
+        if current[key] > limit:
+            regressions.append((key, baseline[key], current[key]))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--qemu", default="qemu-system-i386")
+    parser.add_argument("--kernel", default="build/kernel.elf")
+    parser.add_argument("--results", default="build/results.txt")
+    parser.add_argument("--files", type=int, default=6,
+                        help="워크로드에서 만들 파일 수 (MAX_FILES 이내)")
+    parser.add_argument("--timeout", type=float, default=30.0,
+                        help="명령당 최대 대기 시간 [초]")
+    parser.add_argument("--baseline", help="비교할 기준 결과 파일")
+    parser.add_argument("--threshold", type=float, default=0.25,
+                        help="허용 회귀 비율 (0.25 = 25%%)")
+    args = parser.parse_args()
+
+    current = run_workload(args)
+    print("결과: %s (%d개 지표)" % (args.results, len(current)))
+
+    if args.baseline:
+        # 사이클 값은 호스트/QEMU마다 달라 기준값은 각 환경에서 만든다
+        if not os.path.exists(args.baseline):
+            print("기준 파일이 없어 회귀 검사를 건너뜁니다: %s (make baseline으로 생성)"
+                  % args.baseline)
+            return 0
+        regressions = compare(current, load_results(args.baseline), args.threshold)
+        for key, base, now in regressions:
+            print("REGRESSION %s: %d -> %d (+%.1f%%)"
+                  % (key, base, now, (now - base) * 100.0 / max(base, 1)))
+        if regressions:
+            return 1
+        print("회귀 없음 (threshold %.0f%%)" % (args.threshold * 100))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())